@@ -0,0 +1,142 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "data.h"
+
+#include <compounded_rate.h>
+#include <inverse_modified_following.h>
+
+#include <business_day_conventions.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	// each iteration goes through all the days of a year (so the holidays are hit as often as in real life)
+	constexpr auto _from = 2022y / January / 1d;
+	constexpr auto _until = 2022y / December / 31d;
+
+
+	auto BM_make_maturity_1M(benchmark::State& state) -> void
+	{
+		const auto& publication = bench_SIX();
+
+		for (auto _ : state)
+			for (auto d = sys_days{ _from }; d <= sys_days{ _until }; d += days{ 1 })
+				benchmark::DoNotOptimize(make_maturity(year_month_day{ d }, months{ 1 }, &ModifiedFollowing, publication));
+	}
+
+	auto BM_make_effective_1M(benchmark::State& state) -> void
+	{
+		const auto& publication = bench_SIX();
+
+		for (auto _ : state)
+			for (auto d = sys_days{ _from }; d <= sys_days{ _until }; d += days{ 1 })
+				benchmark::DoNotOptimize(make_effective(year_month_day{ d }, months{ 1 }, &ModifiedPreceding, publication));
+	}
+
+	auto BM_make_effective_1W(benchmark::State& state) -> void
+	{
+		const auto& publication = bench_SIX();
+
+		for (auto _ : state)
+			for (auto d = sys_days{ _from }; d <= sys_days{ _until }; d += days{ 1 })
+				benchmark::DoNotOptimize(make_effective(year_month_day{ d }, weeks{ 1 }, &Preceding, publication));
+	}
+
+	// start dates of 1M SARON windows, as the builders find them
+	auto BM_inverse_modified_following_1M(benchmark::State& state) -> void
+	{
+		const auto& publication = bench_SIX();
+
+		for (auto _ : state)
+			for (auto d = sys_days{ _from }; d <= sys_days{ _until }; d += days{ 1 })
+			{
+				const auto maturity = year_month_day{ d };
+				const auto convention = inverse_modified_following{ maturity, months{ 1 } };
+				benchmark::DoNotOptimize(make_effective(maturity, months{ 1 }, &convention, publication));
+			}
+	}
+
+
+	// business days in each 1M window (as Business/252 needs them)
+	auto BM_count_business_days_1M(benchmark::State& state) -> void
+	{
+		const auto& publication = bench_SIX();
+
+		for (auto _ : state)
+			for (auto d = sys_days{ _from }; d <= sys_days{ _until }; d += days{ 1 })
+			{
+				auto n = 0u;
+				for (auto b = d; b < d + days{ 30 }; b += days{ 1 })
+					if (publication.is_business_day(b))
+						++n;
+				benchmark::DoNotOptimize(n);
+			}
+	}
+
+	auto BM_count_business_days_1M_bitset(benchmark::State& state) -> void
+	{
+		const auto& publication = bench_SIX_bitset();
+
+		for (auto _ : state)
+			for (auto d = sys_days{ _from }; d <= sys_days{ _until }; d += days{ 1 })
+				benchmark::DoNotOptimize(publication.count_business_days(year_month_day{ d }, year_month_day{ d + days{ 30 } }));
+	}
+
+
+	// what every process pays before it can use a calendar
+	auto BM_make_SIX_calendar_from_rules(benchmark::State& state) -> void
+	{
+		for (auto _ : state)
+			benchmark::DoNotOptimize(calendar{ SaturdaySundayWeekend, make_SIX_holiday_schedule_from_rules() });
+	}
+
+	auto BM_make_SIX_calendar(benchmark::State& state) -> void
+	{
+		for (auto _ : state)
+			benchmark::DoNotOptimize(calendar{ SaturdaySundayWeekend, make_SIX_holiday_schedule() });
+	}
+
+
+	BENCHMARK(BM_make_maturity_1M);
+	BENCHMARK(BM_make_effective_1M);
+	BENCHMARK(BM_make_effective_1W);
+	BENCHMARK(BM_inverse_modified_following_1M);
+	BENCHMARK(BM_count_business_days_1M);
+	BENCHMARK(BM_count_business_days_1M_bitset);
+	BENCHMARK(BM_make_SIX_calendar_from_rules);
+	BENCHMARK(BM_make_SIX_calendar);
+
+}
@@ -0,0 +1,366 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "data.h"
+
+#include <compounded_index.h>
+#include <compounded_rate.h>
+#include <compounded_rates.h>
+#include <compounded_publication.h>
+#include <coupon_engine.h>
+#include <compound_tree.h>
+#include <accrual_factors.h>
+
+#include <compounding_schedule.h>
+#include <coupon_period.h>
+#include <business_day_conventions.h>
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <execution>
+#include <vector>
+
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	auto BM_compound_EuroSTR_3M(benchmark::State& state) -> void
+	{
+		const auto& r = bench_EuroSTR();
+		const auto& publication = bench_TARGET2();
+
+		const auto effective = 2022y / June / 30d;
+		const auto maturity = 2022y / September / 30d;
+		const auto schedule = coupon_schedule::make_compounding_schedule({ { effective, maturity }, maturity, maturity }, publication);
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(compound(schedule, r));
+	}
+
+	// since inception
+
+	inline auto _bench_SARON_history() -> const coupon_schedule::compounding_periods&
+	{
+		static const auto schedule = [] {
+			const auto& publication = bench_SIX();
+
+			const auto from = 1999y / June / 30d;
+			const auto until = coupon_schedule::make_overnight_maturity(bench_SARON().last_reset_year_month_day(), publication);
+
+			return coupon_schedule::make_compounding_schedule({ { from, until }, until, until }, publication);
+		}();
+
+		return schedule;
+	}
+
+	auto BM_compound_SARON_history(benchmark::State& state) -> void
+	{
+		const auto& r = bench_SARON();
+		const auto& schedule = _bench_SARON_history();
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(compound(schedule, r));
+	}
+
+	auto BM_compound_tree_SARON_history(benchmark::State& state) -> void
+	{
+		const auto& r = bench_SARON();
+		const auto& schedule = _bench_SARON_history();
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(compound_tree(std::execution::par, schedule, r));
+	}
+
+	auto BM_make_compounded_index_EuroSTR(benchmark::State& state) -> void
+	{
+		const auto& r = bench_EuroSTR();
+		const auto& publication = bench_TARGET2();
+
+		for (auto _ : state)
+		{
+			auto ci = make_compounded_index(r, 2019y / October / 1d, publication, 8u);
+			benchmark::DoNotOptimize(ci);
+		}
+	}
+
+	auto BM_make_compounded_index2_SARON_dense(benchmark::State& state) -> void
+	{
+		const auto& r = bench_SARON();
+		const auto& publication = bench_SIX_dense();
+
+		for (auto _ : state)
+		{
+			auto ci = make_compounded_index2(r, 1999y / June / 30d, publication, 6u, 10'000.0);
+			benchmark::DoNotOptimize(ci);
+		}
+	}
+
+	auto BM_make_compounded_index_par_EuroSTR(benchmark::State& state) -> void
+	{
+		const auto& r = bench_EuroSTR();
+		const auto& publication = bench_TARGET2();
+
+		for (auto _ : state)
+		{
+			auto ci = make_compounded_index(std::execution::par, r, 2019y / October / 1d, publication, 8u);
+			benchmark::DoNotOptimize(ci);
+		}
+	}
+
+	auto BM_make_compounded_index2_SARON(benchmark::State& state) -> void
+	{
+		const auto& r = bench_SARON();
+		const auto& publication = bench_SIX();
+
+		for (auto _ : state)
+		{
+			auto ci = make_compounded_index2(r, 1999y / June / 30d, publication, 6u, 10'000.0);
+			benchmark::DoNotOptimize(ci);
+		}
+	}
+
+
+	// a book of quarterly EuroSTR coupons (each business day of 2021 as the start, each of them in 10 trades)
+	inline auto _bench_book() -> const vector<coupon_schedule::coupon_period>&
+	{
+		static const auto book = [] {
+			const auto& publication = bench_TARGET2();
+
+			auto result = vector<coupon_schedule::coupon_period>{};
+			for (auto repeat = 0; repeat < 10; ++repeat)
+				for (auto effective = 2021y / January / 4d; effective <= 2021y / December / 31d; effective = coupon_schedule::make_overnight_maturity(effective, publication))
+				{
+					const auto maturity = make_maturity(effective, months{ 3 }, &ModifiedFollowing, publication);
+					result.emplace_back(days_period{ effective, maturity }, maturity, maturity);
+				}
+
+			return result;
+		}();
+
+		return book;
+	}
+
+	auto BM_compound_book_EuroSTR(benchmark::State& state) -> void
+	{
+		const auto& r = bench_EuroSTR();
+		const auto& publication = bench_TARGET2();
+		const auto& book = _bench_book();
+
+		for (auto _ : state)
+			for (const auto& c : book)
+				benchmark::DoNotOptimize(compound(coupon_schedule::make_compounding_schedule(c, publication), r));
+	}
+
+	auto BM_compound_coupons_EuroSTR(benchmark::State& state) -> void
+	{
+		const auto& book = _bench_book();
+
+		for (auto _ : state)
+		{
+			// the factors are part of the cost
+			const auto factors = accrual_factors{ bench_EuroSTR(), 2019y / October / 1d, bench_TARGET2() };
+
+			auto rates = compound_coupons(std::execution::par, factors, book);
+			benchmark::DoNotOptimize(rates);
+		}
+	}
+
+
+	template<typename T>
+	auto _bench_make_compounded_rate(
+		benchmark::State& state,
+		const T& term,
+		const resets& r,
+		const year_month_day& from,
+		const business_day_convention* const convention,
+		const calendar& publication,
+		const unsigned decimal_places
+	) -> void
+	{
+		for (auto _ : state)
+		{
+			auto cr = make_compounded_rate(term, r, from, convention, publication, decimal_places);
+			benchmark::DoNotOptimize(cr);
+		}
+	}
+
+	// BENCHMARK_CAPTURE does not accept templates, hence a function for each type of the term
+
+	auto BM_make_compounded_rate_EuroSTR_weeks(benchmark::State& state, const weeks term, const business_day_convention* const convention) -> void
+	{
+		_bench_make_compounded_rate(state, term, bench_EuroSTR(), 2019y / October / 1d, convention, bench_TARGET2(), 5u);
+	}
+
+	auto BM_make_compounded_rate_EuroSTR_months(benchmark::State& state, const months term, const business_day_convention* const convention) -> void
+	{
+		_bench_make_compounded_rate(state, term, bench_EuroSTR(), 2019y / October / 1d, convention, bench_TARGET2(), 5u);
+	}
+
+	// from dates as in the tests
+	auto BM_make_compounded_rate_SARON_weeks(benchmark::State& state, const weeks term, const business_day_convention* const convention) -> void
+	{
+		_bench_make_compounded_rate(state, term, bench_SARON(), 2000y / June / 23d, convention, bench_SIX(), 4u);
+	}
+
+	// the monthly SARON tenors start on inverse_modified_following, which depends on the maturity,
+	// so they are built through a tenor (as the SARON publication is)
+	auto BM_make_compounded_rate_SARON_months(benchmark::State& state, const months term) -> void
+	{
+		const auto tenors = vector<tenor>{ tenor{ term } };
+
+		for (auto _ : state)
+		{
+			auto cr = make_compounded_rates(tenors, bench_SARON(), 1999y / June / 30d, bench_SIX(), 4u);
+			benchmark::DoNotOptimize(cr);
+		}
+	}
+
+	// the same with the start dates precomputed (the table is built once per calendar and term, so it is not timed)
+	auto BM_make_compounded_rate_SARON_months_table(benchmark::State& state, const months term) -> void
+	{
+		const auto& publication = bench_SIX();
+
+		const auto from = 1999y / June / 30d;
+		const auto until = coupon_schedule::make_overnight_maturity(bench_SARON().last_reset_year_month_day(), publication);
+		const auto table = inverse_modified_following_table{ publication, term, days_period{ from, until } };
+		const auto tenors = vector<tenor>{ tenor{ &table } };
+
+		for (auto _ : state)
+		{
+			auto cr = make_compounded_rates(tenors, bench_SARON(), from, publication, 4u);
+			benchmark::DoNotOptimize(cr);
+		}
+	}
+
+
+	// a single 3M SARON rate: from the whole history and on its own
+	auto BM_make_compounded_rate_SARON_3M_one(benchmark::State& state) -> void
+	{
+		const auto maturity = 2022y / June / 30d;
+
+		for (auto _ : state)
+		{
+			const auto cr = make_compounded_rate(months{ 3 }, bench_SARON(), 1999y / June / 30d, &ModifiedPreceding, bench_SIX(), 4u);
+			benchmark::DoNotOptimize(cr.get_time_series()[maturity]);
+		}
+	}
+
+	auto BM_compounded_rate_at_SARON_3M(benchmark::State& state) -> void
+	{
+		const auto maturity = 2022y / June / 30d;
+
+		for (auto _ : state)
+			benchmark::DoNotOptimize(compounded_rate_at(maturity, months{ 3 }, &ModifiedPreceding, bench_SIX(), bench_SARON(), 4u));
+	}
+
+
+	// the SARON publication (index and tenors) done separately and then in one walk
+
+	inline auto _bench_SARON_tenors() -> vector<tenor>
+	{
+		return {
+			{ weeks{ 1 }, &Preceding },
+			tenor{ months{ 1 } },
+			tenor{ months{ 2 } },
+			tenor{ months{ 3 } },
+			tenor{ months{ 6 } },
+			tenor{ months{ 9 } },
+			tenor{ months{ 12 } }
+		};
+	}
+
+	auto BM_publication_SARON_separately(benchmark::State& state) -> void
+	{
+		const auto& r = bench_SARON();
+		const auto& publication = bench_SIX();
+		const auto tenors = _bench_SARON_tenors();
+
+		for (auto _ : state)
+		{
+			auto ci = make_compounded_index2(r, 1999y / June / 30d, publication, 6u, 10'000.0);
+			benchmark::DoNotOptimize(ci);
+
+			for (const auto& t : tenors)
+			{
+				auto cr = make_compounded_rates({ t }, r, 1999y / June / 30d, publication, 4u);
+				benchmark::DoNotOptimize(cr);
+			}
+		}
+	}
+
+	auto BM_publication_SARON_pipeline(benchmark::State& state) -> void
+	{
+		const auto& r = bench_SARON();
+		const auto& publication = bench_SIX();
+		const auto pipeline = publication_pipeline{ SARONCompoundedIndexConvention, _bench_SARON_tenors(), 4u, 10'000.0 };
+
+		for (auto _ : state)
+		{
+			auto p = pipeline.run(r, 1999y / June / 30d, publication);
+			benchmark::DoNotOptimize(p);
+		}
+	}
+
+
+	BENCHMARK(BM_compound_EuroSTR_3M);
+	BENCHMARK(BM_compound_SARON_history);
+	BENCHMARK(BM_compound_tree_SARON_history);
+	BENCHMARK(BM_make_compounded_index_EuroSTR);
+	BENCHMARK(BM_make_compounded_index_par_EuroSTR);
+	BENCHMARK(BM_make_compounded_index2_SARON);
+	BENCHMARK(BM_make_compounded_index2_SARON_dense);
+	BENCHMARK(BM_compound_book_EuroSTR);
+	BENCHMARK(BM_compound_coupons_EuroSTR);
+	BENCHMARK(BM_publication_SARON_separately);
+	BENCHMARK(BM_publication_SARON_pipeline);
+	BENCHMARK(BM_make_compounded_rate_SARON_3M_one);
+	BENCHMARK(BM_compounded_rate_at_SARON_3M);
+
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_EuroSTR_weeks, 1W, weeks{ 1 }, &Preceding);
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_EuroSTR_months, 1M, months{ 1 }, &ModifiedPreceding);
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_EuroSTR_months, 3M, months{ 3 }, &ModifiedPreceding);
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_EuroSTR_months, 6M, months{ 6 }, &ModifiedPreceding);
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_EuroSTR_months, 12M, months{ 12 }, &ModifiedPreceding);
+
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_weeks, 1W, weeks{ 1 }, &Preceding);
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months, 1M, months{ 1 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months, 2M, months{ 2 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months, 3M, months{ 3 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months, 6M, months{ 6 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months, 9M, months{ 9 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months, 12M, months{ 12 });
+
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months_table, 1M, months{ 1 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months_table, 2M, months{ 2 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months_table, 3M, months{ 3 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months_table, 6M, months{ 6 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months_table, 9M, months{ 9 });
+	BENCHMARK_CAPTURE(BM_make_compounded_rate_SARON_months_table, 12M, months{ 12 });
+
+}
@@ -0,0 +1,111 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <setup.h>
+
+#include <dense_calendar.h>
+#include <bitset_calendar.h>
+
+#include <resets.h>
+
+#include <day_counts.h>
+
+#include <weekend.h>
+#include <calendar.h>
+
+#include <string>
+#include <chrono>
+
+
+namespace risk_free_rate
+{
+
+	// resets and calendars from test/data, loaded once and shared by all the benchmarks
+
+	inline auto bench_path(const std::string& file) -> std::string
+	{
+		return std::string{ RISK_FREE_RATE_DATA } + file;
+	}
+
+	inline auto bench_EuroSTR() -> const resets&
+	{
+		static const auto r = resets{
+			load_fixings(bench_path(EuroSTR), "Period", "Volume-weighted trimmed mean rate"),
+			&coupon_schedule::Actual360
+		};
+
+		return r;
+	}
+
+	inline auto bench_SARON() -> const resets&
+	{
+		static const auto r = resets{
+			load_fixings(bench_path(SARON), "Date", "Swiss Average Rate ON", ';'),
+			&coupon_schedule::Actual360
+		};
+
+		return r;
+	}
+
+	inline auto bench_TARGET2() -> const gregorian::calendar&
+	{
+		static const auto c = gregorian::calendar{
+			gregorian::SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+
+		return c;
+	}
+
+	inline auto bench_SIX() -> const gregorian::calendar&
+	{
+		static const auto c = gregorian::calendar{
+			gregorian::SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		return c;
+	}
+
+	inline auto bench_SIX_dense() -> const dense_calendar&
+	{
+		static const auto c = dense_calendar{
+			bench_SIX(),
+			{ std::chrono::year{ 1999 } / 1 / 1, std::chrono::year{ 2024 } / 12 / 31 }
+		};
+
+		return c;
+	}
+
+	inline auto bench_SIX_bitset() -> const bitset_calendar&
+	{
+		static const auto c = bitset_calendar{
+			bench_SIX(),
+			{ std::chrono::year{ 1999 } / 1 / 1, std::chrono::year{ 2024 } / 12 / 31 }
+		};
+
+		return c;
+	}
+
+}
@@ -0,0 +1,136 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "data.h"
+
+#include <fixing_file.h>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+
+using namespace std;
+
+
+namespace risk_free_rate
+{
+
+	// loads the file once per iteration, which is what happens at startup
+	template<typename Loader>
+	auto _load(benchmark::State& state, Loader loader, const string& file, const string& date, const string& observation, const char separator) -> void
+	{
+		const auto path = bench_path(file);
+
+		const auto size = static_cast<int64_t>(mapped_file{ path }.view().size());
+
+		for (auto _ : state)
+		{
+			auto ts = loader(path, date, observation, separator);
+			benchmark::DoNotOptimize(ts);
+		}
+
+		state.SetBytesProcessed(state.iterations() * size);
+	}
+
+
+	// load_fixings is overloaded, so it cannot be passed as it is
+	const auto _load_fixings = [](const string& file, const string& date, const string& observation, const char separator) {
+		return load_fixings(file, date, observation, separator);
+	};
+
+
+	auto BM_parse_csv_rapidcsv_SONIA(benchmark::State& state) -> void
+	{
+		_load(state, parse_csv_rapidcsv, SONIA, "Date"s, "Daily Sterling overnight index average (SONIA) rate              [a] [b]             IUDSOIA"s, ',');
+	}
+
+	auto BM_load_fixings_SONIA(benchmark::State& state) -> void
+	{
+		_load(state, _load_fixings, SONIA, "Date"s, "Daily Sterling overnight index average (SONIA) rate              [a] [b]             IUDSOIA"s, ',');
+	}
+
+	auto BM_parse_csv_rapidcsv_EuroSTR(benchmark::State& state) -> void
+	{
+		_load(state, parse_csv_rapidcsv, EuroSTR, "Period"s, "Volume-weighted trimmed mean rate"s, ',');
+	}
+
+	auto BM_load_fixings_EuroSTR(benchmark::State& state) -> void
+	{
+		_load(state, _load_fixings, EuroSTR, "Period"s, "Volume-weighted trimmed mean rate"s, ',');
+	}
+
+	auto BM_parse_csv_rapidcsv_SARON(benchmark::State& state) -> void
+	{
+		_load(state, parse_csv_rapidcsv, SARON, "Date"s, "Swiss Average Rate ON"s, ';');
+	}
+
+	auto BM_load_fixings_SARON(benchmark::State& state) -> void
+	{
+		_load(state, _load_fixings, SARON, "Date"s, "Swiss Average Rate ON"s, ';');
+	}
+
+	// all 4 columns of SARON.csv: one pass over the file versus a pass for each column
+	const auto _SARON_columns = vector<string_view>{
+		"Swiss Average Rate ON",
+		"SARON Index",
+		"Swiss Current Rate ON",
+		"Swiss Current Index ON"
+	};
+
+	auto BM_load_fixings_SARON_columns(benchmark::State& state) -> void
+	{
+		const auto path = bench_path(SARON);
+
+		for (auto _ : state)
+		{
+			auto columns = load_fixings(path, "Date", _SARON_columns, ';');
+			benchmark::DoNotOptimize(columns);
+		}
+	}
+
+	auto BM_load_fixings_SARON_column_by_column(benchmark::State& state) -> void
+	{
+		const auto path = bench_path(SARON);
+
+		for (auto _ : state)
+			for (const auto& column : _SARON_columns)
+			{
+				auto ts = load_fixings(path, "Date", column, ';');
+				benchmark::DoNotOptimize(ts);
+			}
+	}
+
+
+	BENCHMARK(BM_parse_csv_rapidcsv_SONIA);
+	BENCHMARK(BM_load_fixings_SONIA);
+	BENCHMARK(BM_parse_csv_rapidcsv_EuroSTR);
+	BENCHMARK(BM_load_fixings_EuroSTR);
+	BENCHMARK(BM_parse_csv_rapidcsv_SARON);
+	BENCHMARK(BM_load_fixings_SARON);
+	BENCHMARK(BM_load_fixings_SARON_columns);
+	BENCHMARK(BM_load_fixings_SARON_column_by_column);
+
+}
@@ -0,0 +1,59 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "data.h"
+
+#include <resets_snapshot.h>
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <string>
+
+
+using namespace std;
+
+
+namespace risk_free_rate
+{
+
+	// cold start from a snapshot (compare with BM_load_fixings_SARON)
+	auto BM_resets_view_SARON(benchmark::State& state) -> void
+	{
+		const auto& r = bench_SARON();
+
+		const auto file_name = (filesystem::temp_directory_path() / "SARON.rfr").string();
+		write_snapshot(r, file_name);
+
+		for (auto _ : state)
+		{
+			const auto view = resets_view{ file_name };
+			benchmark::DoNotOptimize(view.get_period());
+		}
+
+		filesystem::remove(file_name);
+	}
+
+
+	BENCHMARK(BM_resets_view_SARON);
+
+}
@@ -0,0 +1,236 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "compounding_conventions.h"
+#include "dense_calendar.h"
+#include "serial_date.h"
+
+#include <resets.h>
+
+#include <compounding_schedule.h>
+
+#include <period.h>
+#include <calendar.h>
+
+#include <chrono>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace risk_free_rate
+{
+
+	// daily growth factors of the resets (for each business day of the publication calendar),
+	// which are calculated once and then can be used to compound over any period
+	class accrual_factors final
+	{
+
+	public:
+
+		template<publication_calendar Calendar>
+		explicit accrual_factors(
+			const resets& r,
+			std::chrono::year_month_day from,
+			const Calendar& publication
+		);
+
+	public:
+
+		// compounded rate over [from, until) in constant time (both dates are expected to be business days)
+		auto compound(const std::chrono::year_month_day& from, const std::chrono::year_month_day& until) const -> double;
+
+		// growth of 1.0 over [from, until)
+		auto growth(const std::chrono::year_month_day& from, const std::chrono::year_month_day& until) const -> double;
+
+	public:
+
+		// position of the business day in the dates below
+		// (non-business days are mapped onto the following business day)
+		auto slot(const std::chrono::year_month_day& ymd) const -> std::size_t;
+
+		auto get_period() const noexcept -> const gregorian::days_period&;
+		auto get_day_count() const noexcept -> const coupon_schedule::day_count*;
+
+		// business days from "from" to the maturity of the last reset
+		auto get_dates() const noexcept -> const std::vector<std::chrono::year_month_day>&;
+
+		// year fraction and 1 + rate * year fraction for each overnight period starting on dates[i]
+		// (there is one less of them than dates)
+		auto get_year_fractions() const noexcept -> const std::vector<double>&;
+		auto get_factors() const noexcept -> const std::vector<double>&;
+
+	private:
+
+		gregorian::days_period _period;
+
+		const coupon_schedule::day_count* _day_count;
+
+		std::vector<std::chrono::year_month_day> _dates;
+		std::vector<double> _year_fractions;
+		std::vector<double> _factors;
+
+		// running product of factors stored as unevaluated sum of two doubles,
+		// so ratios of them are (almost) as accurate as compounding the period directly
+		// (cumulative[i] is the product of factors before dates[i])
+		std::vector<double> _cumulative_hi;
+		std::vector<double> _cumulative_lo;
+
+		std::vector<std::uint32_t> _slots; // for each calendar day in _period
+
+	};
+
+
+	template<publication_calendar Calendar>
+	accrual_factors::accrual_factors(
+		const resets& r,
+		std::chrono::year_month_day from,
+		const Calendar& publication
+	) :
+		_period{},
+		_day_count{ r.get_day_count() },
+		_dates{},
+		_year_fractions{},
+		_factors{},
+		_cumulative_hi{},
+		_cumulative_lo{},
+		_slots{}
+	{
+		const auto& last_reset_ymd = r.last_reset_year_month_day();
+
+		const auto until = _make_business_day(_make_overnight_maturity(last_reset_ymd, publication));
+
+		auto hi = 1.0;
+		auto lo = 0.0;
+
+		// serial dates of _dates (for the slots below)
+		auto serials = std::vector<serial_date>{};
+
+		_dates.push_back(from);
+		serials.push_back(to_serial(from));
+		_cumulative_hi.push_back(hi);
+		_cumulative_lo.push_back(lo);
+
+		_visit_day_count(
+			_day_count,
+			[&](const auto& day_count)
+			{
+				for (auto d = _make_business_day(from); d._serial < until._serial;)
+				{
+					const auto effective = d;
+					const auto maturity = _make_overnight_maturity(d, publication);
+					const auto year_fraction = day_count.fraction(effective._serial, maturity._serial);
+					const auto factor = _growth(day_count, r[effective._ymd], year_fraction);
+
+					// (hi + lo) * factor without losing the rounding error of hi * factor
+					const auto p = hi * factor;
+					const auto e = std::fma(hi, factor, -p) + lo * factor;
+					hi = p + e;
+					lo = e - (hi - p);
+
+					_dates.push_back(maturity._ymd);
+					serials.push_back(maturity._serial);
+					_year_fractions.push_back(year_fraction);
+					_factors.push_back(factor);
+					_cumulative_hi.push_back(hi);
+					_cumulative_lo.push_back(lo);
+
+					d = maturity;
+				}
+			}
+		);
+
+		_period = gregorian::days_period{ std::move(from), until._ymd };
+
+		const auto first = serials.front();
+		_slots.reserve(until._serial - first + 1);
+		auto s = std::uint32_t{ 0u };
+		for (auto d = first; d <= until._serial; ++d)
+		{
+			if (serials[s] < d)
+				++s;
+
+			_slots.push_back(s);
+		}
+	}
+
+
+	inline auto accrual_factors::compound(const std::chrono::year_month_day& from, const std::chrono::year_month_day& until) const -> double
+	{
+		const auto c = growth(from, until);
+
+		return _visit_day_count(
+			_day_count,
+			[&](const auto& dc) { return _rate(dc, c, dc.fraction(to_serial(from), to_serial(until))); }
+		);
+	}
+
+	inline auto accrual_factors::growth(const std::chrono::year_month_day& from, const std::chrono::year_month_day& until) const -> double
+	{
+		const auto i = slot(from);
+		const auto j = slot(until);
+
+		// (hi_j + lo_j) / (hi_i + lo_i) with one correction step
+		const auto q = _cumulative_hi[j] / _cumulative_hi[i];
+		const auto r = std::fma(-q, _cumulative_hi[i], _cumulative_hi[j]) + _cumulative_lo[j] - q * _cumulative_lo[i];
+
+		return q + r / _cumulative_hi[i];
+	}
+
+
+	inline auto accrual_factors::slot(const std::chrono::year_month_day& ymd) const -> std::size_t
+	{
+		const auto i = to_serial(ymd) - to_serial(_period.get_from());
+
+		return _slots.at(static_cast<std::size_t>(i)); // throws if ymd is outside of the period (negative i included)
+	}
+
+
+	inline auto accrual_factors::get_period() const noexcept -> const gregorian::days_period&
+	{
+		return _period;
+	}
+
+	inline auto accrual_factors::get_day_count() const noexcept -> const coupon_schedule::day_count*
+	{
+		return _day_count;
+	}
+
+	inline auto accrual_factors::get_dates() const noexcept -> const std::vector<std::chrono::year_month_day>&
+	{
+		return _dates;
+	}
+
+	inline auto accrual_factors::get_year_fractions() const noexcept -> const std::vector<double>&
+	{
+		return _year_fractions;
+	}
+
+	inline auto accrual_factors::get_factors() const noexcept -> const std::vector<double>&
+	{
+		return _factors;
+	}
+
+}
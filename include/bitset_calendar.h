@@ -0,0 +1,253 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "dense_calendar.h"
+#include "instrumentation.h"
+#include "serial_date.h"
+
+#include <period.h>
+#include <calendar.h>
+
+#include <chrono>
+#include <vector>
+#include <bit>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace risk_free_rate
+{
+
+	// business days of a calendar over a period packed into 64 bit words (one bit a day),
+	// so the number of business days between two dates is a couple of popcounts rather than
+	// a call to is_business_day for each day (as needed for Business/252)
+	class bitset_calendar final
+	{
+
+	public:
+
+		explicit bitset_calendar(
+			const gregorian::calendar& cal,
+			gregorian::days_period from_until
+		);
+
+		// we keep a pointer to the calendar, so it has to outlive us
+		bitset_calendar(gregorian::calendar&&, gregorian::days_period) = delete;
+
+	public:
+
+		auto is_business_day(const std::chrono::year_month_day& ymd) const -> bool;
+		auto is_business_day(const serial_date d) const -> bool;
+
+		// the first business day after d (the same as coupon_schedule::make_overnight_maturity)
+		auto next_business_day(const std::chrono::year_month_day& ymd) const -> std::chrono::year_month_day;
+		auto next_business_day(const serial_date d) const -> serial_date;
+
+		// number of business days in [from, until)
+		auto count_business_days(const std::chrono::year_month_day& from, const std::chrono::year_month_day& until) const -> std::size_t;
+		auto count_business_days(const serial_date from, const serial_date until) const -> std::size_t;
+
+	public:
+
+		auto get_calendar() const noexcept -> const gregorian::calendar&;
+		auto get_period() const noexcept -> const gregorian::days_period&;
+
+	private:
+
+		auto _index(const serial_date d) const -> std::size_t;
+
+		// number of business days in the period before the day with index i
+		auto _rank(const std::size_t i) const noexcept -> std::size_t;
+
+	private:
+
+		const gregorian::calendar* _calendar;
+
+		gregorian::days_period _period;
+
+		serial_date _from;
+		serial_date _until;
+
+		std::vector<std::uint64_t> _words; // bit i % 64 of word i / 64 is set if day i of the period is a business day
+		std::vector<std::uint32_t> _ranks; // number of business days before each word
+
+		serial_date _next; // the first business day after the period
+
+	};
+
+
+	inline bitset_calendar::bitset_calendar(
+		const gregorian::calendar& cal,
+		gregorian::days_period from_until
+	) :
+		_calendar{ &cal },
+		_period{ std::move(from_until) },
+		_from{ to_serial(_period.get_from()) },
+		_until{ to_serial(_period.get_until()) },
+		_words{},
+		_ranks{},
+		_next{}
+	{
+		const auto size = static_cast<std::size_t>(_until - _from + 1);
+
+		_words.resize((size + 63u) / 64u);
+		for (auto i = std::size_t{ 0u }; i < size; ++i)
+			if (cal.is_business_day(to_sys_days(_from + static_cast<serial_date>(i))))
+				_words[i / 64u] |= std::uint64_t{ 1u } << (i % 64u);
+
+		_ranks.reserve(_words.size());
+		auto rank = std::uint32_t{ 0u };
+		for (const auto w : _words)
+		{
+			_ranks.push_back(rank);
+			rank += static_cast<std::uint32_t>(std::popcount(w));
+		}
+
+		auto next = to_sys_days(_until) + std::chrono::days{ 1 };
+		while (!cal.is_business_day(next))
+			next += std::chrono::days{ 1 };
+
+		_next = to_serial(next);
+	}
+
+
+	inline auto bitset_calendar::is_business_day(const std::chrono::year_month_day& ymd) const -> bool
+	{
+		return is_business_day(to_serial(ymd));
+	}
+
+	inline auto bitset_calendar::is_business_day(const serial_date d) const -> bool
+	{
+		const auto i = _index(d);
+
+		return (_words[i / 64u] >> (i % 64u)) & 1u;
+	}
+
+	inline auto bitset_calendar::next_business_day(const std::chrono::year_month_day& ymd) const -> std::chrono::year_month_day
+	{
+		return from_serial(next_business_day(to_serial(ymd)));
+	}
+
+	inline auto bitset_calendar::next_business_day(const serial_date d) const -> serial_date
+	{
+		const auto i = _index(d) + 1u;
+
+		// the rest of the word of i and then whole words
+		auto w = i / 64u;
+		if (w < _words.size())
+		{
+			auto bits = _words[w] & (~std::uint64_t{ 0u } << (i % 64u));
+			while (!bits && ++w < _words.size())
+				bits = _words[w];
+
+			if (bits)
+				return _from + static_cast<serial_date>(w * 64u + std::countr_zero(bits));
+		}
+
+		return _next;
+	}
+
+	inline auto bitset_calendar::count_business_days(const std::chrono::year_month_day& from, const std::chrono::year_month_day& until) const -> std::size_t
+	{
+		return count_business_days(to_serial(from), to_serial(until));
+	}
+
+	inline auto bitset_calendar::count_business_days(const serial_date from, const serial_date until) const -> std::size_t
+	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
+		if (until < from)
+			throw std::invalid_argument{ "Period should not end before it starts" };
+
+		// until itself is not counted, so it can be the day after the period
+		const auto i = _index(from);
+		const auto j = until == _until + 1 ? _index(_until) + 1u : _index(until);
+
+		return _rank(j) - _rank(i);
+	}
+
+
+	inline auto bitset_calendar::get_calendar() const noexcept -> const gregorian::calendar&
+	{
+		return *_calendar;
+	}
+
+	inline auto bitset_calendar::get_period() const noexcept -> const gregorian::days_period&
+	{
+		return _period;
+	}
+
+
+	inline auto bitset_calendar::_index(const serial_date d) const -> std::size_t
+	{
+		if (d < _from || d > _until)
+			throw std::out_of_range{ "Date is outside of the bitset calendar" };
+
+		return static_cast<std::size_t>(d - _from);
+	}
+
+	inline auto bitset_calendar::_rank(const std::size_t i) const noexcept -> std::size_t
+	{
+		const auto w = i / 64u;
+		if (w == _words.size()) // just past the end of the last (full) word
+			return _ranks.back() + std::popcount(_words.back());
+
+		const auto mask = (std::uint64_t{ 1u } << (i % 64u)) - 1u;
+
+		return _ranks[w] + std::popcount(_words[w] & mask);
+	}
+
+
+
+	// so the builders can use it as a publication calendar (see dense_calendar.h)
+
+	inline auto _make_overnight_maturity(
+		const std::chrono::year_month_day& ymd,
+		const bitset_calendar& publication
+	) -> std::chrono::year_month_day
+	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
+		return publication.next_business_day(ymd);
+	}
+
+	inline auto _make_overnight_maturity(
+		const _business_day& d,
+		const bitset_calendar& publication
+	) -> _business_day
+	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
+		const auto maturity = publication.next_business_day(d._serial);
+
+		return { maturity, from_serial(maturity) };
+	}
+
+
+	inline auto _get_calendar(const bitset_calendar& publication) noexcept -> const gregorian::calendar&
+	{
+		return publication.get_calendar();
+	}
+
+}
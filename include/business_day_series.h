@@ -0,0 +1,265 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "dense_calendar.h"
+
+#include <resets.h>
+
+#include <period.h>
+#include <time_series.h>
+
+#include <chrono>
+#include <optional>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace risk_free_rate
+{
+
+	// a series which has values on business days only (resets, compounded rates or indices),
+	// stored as packed doubles and a bitmap of which of them are there
+	// (resets::storage keeps an optional<double> for every calendar day, which is about 3 times more memory)
+	// the position of a date is its business day ordinal in the dense calendar, which has to outlive the series
+	class business_day_series final
+	{
+
+	public:
+
+		// assignable from optional<double> (so builders can write into the series as into resets::storage)
+		class reference final
+		{
+
+		public:
+
+			auto operator=(const std::optional<double>& o) -> reference&;
+
+			operator std::optional<double>() const;
+
+		private:
+
+			friend class business_day_series;
+
+			reference(business_day_series* const series, const std::size_t slot) noexcept;
+
+		private:
+
+			business_day_series* _series;
+			std::size_t _slot;
+
+		};
+
+	public:
+
+		// empty series for the business days of the period (which should be covered by the calendar)
+		explicit business_day_series(
+			const dense_calendar& publication,
+			gregorian::days_period from_until
+		);
+
+		// compacts resets::storage (throws if it has a value on a non-business day)
+		explicit business_day_series(
+			const dense_calendar& publication,
+			const resets::storage& ts
+		);
+
+		// we keep a pointer to the dense calendar, so it has to outlive us
+		business_day_series(dense_calendar&&, gregorian::days_period) = delete;
+		business_day_series(dense_calendar&&, const resets::storage&) = delete;
+
+	public:
+
+		// nothing for a non-business day (as well as for a business day without a value)
+		auto operator[](const std::chrono::year_month_day& ymd) const -> std::optional<double>;
+
+		// throws for a non-business day
+		auto operator[](const std::chrono::year_month_day& ymd) -> reference;
+
+		auto to_storage() const -> resets::storage;
+
+	public:
+
+		auto get_period() const noexcept -> const gregorian::days_period&;
+		auto get_calendar() const noexcept -> const dense_calendar&;
+
+		// number of business days in the period
+		auto size() const noexcept -> std::size_t;
+
+		// memory used by the values and the bitmap
+		auto size_in_bytes() const noexcept -> std::size_t;
+
+	private:
+
+		auto _slot(const std::chrono::year_month_day& ymd) const -> std::optional<std::size_t>;
+
+		auto _is_valid(const std::size_t slot) const noexcept -> bool;
+
+	private:
+
+		const dense_calendar* _publication;
+
+		gregorian::days_period _period;
+
+		std::size_t _first; // business day ordinal of the first business day of the period
+
+		std::vector<double> _values;
+		std::vector<std::uint64_t> _valid;
+
+	};
+
+
+	inline business_day_series::reference::reference(business_day_series* const series, const std::size_t slot) noexcept :
+		_series{ series },
+		_slot{ slot }
+	{
+	}
+
+	inline auto business_day_series::reference::operator=(const std::optional<double>& o) -> reference&
+	{
+		// different slots can be written from different threads (as make_compounded_rate does),
+		// but they might share the word of the bitmap
+		auto word = std::atomic_ref<std::uint64_t>{ _series->_valid[_slot / 64u] };
+		const auto bit = std::uint64_t{ 1u } << (_slot % 64u);
+
+		if (o)
+		{
+			_series->_values[_slot] = *o;
+			word.fetch_or(bit, std::memory_order_relaxed);
+		}
+		else
+			word.fetch_and(~bit, std::memory_order_relaxed);
+
+		return *this;
+	}
+
+	inline business_day_series::reference::operator std::optional<double>() const
+	{
+		if (_series->_is_valid(_slot))
+			return _series->_values[_slot];
+		else
+			return std::nullopt;
+	}
+
+
+	inline business_day_series::business_day_series(
+		const dense_calendar& publication,
+		gregorian::days_period from_until
+	) :
+		_publication{ &publication },
+		_period{ std::move(from_until) },
+		_first{ publication.business_day_ordinal(_period.get_from()) },
+		_values{},
+		_valid{}
+	{
+		const auto& until = _period.get_until();
+
+		const auto size = publication.business_day_ordinal(until) + publication.is_business_day(until) - _first;
+
+		_values.resize(size);
+		_valid.resize((size + 63u) / 64u);
+	}
+
+	inline business_day_series::business_day_series(
+		const dense_calendar& publication,
+		const resets::storage& ts
+	) :
+		business_day_series{ publication, ts.get_period() }
+	{
+		for (auto d = std::chrono::sys_days{ _period.get_from() }; d <= std::chrono::sys_days{ _period.get_until() }; d += std::chrono::days{ 1 })
+			if (const auto& o = ts[d])
+			{
+				if (!publication.is_business_day(d))
+					throw std::invalid_argument{ "Value on a non-business day can not be stored in business_day_series" };
+
+				(*this)[d] = o;
+			}
+	}
+
+
+	inline auto business_day_series::operator[](const std::chrono::year_month_day& ymd) const -> std::optional<double>
+	{
+		const auto s = _slot(ymd);
+		if (s && _is_valid(*s))
+			return _values[*s];
+		else
+			return std::nullopt;
+	}
+
+	inline auto business_day_series::operator[](const std::chrono::year_month_day& ymd) -> reference
+	{
+		const auto s = _slot(ymd);
+		if (!s)
+			throw std::out_of_range{ "Date is not a business day of business_day_series" };
+
+		return reference{ this, *s };
+	}
+
+	inline auto business_day_series::to_storage() const -> resets::storage
+	{
+		auto result = resets::storage{ _period };
+
+		for (auto d = std::chrono::sys_days{ _period.get_from() }; d <= std::chrono::sys_days{ _period.get_until() }; d += std::chrono::days{ 1 })
+			result[d] = (*this)[d];
+
+		return result;
+	}
+
+
+	inline auto business_day_series::get_period() const noexcept -> const gregorian::days_period&
+	{
+		return _period;
+	}
+
+	inline auto business_day_series::get_calendar() const noexcept -> const dense_calendar&
+	{
+		return *_publication;
+	}
+
+	inline auto business_day_series::size() const noexcept -> std::size_t
+	{
+		return _values.size();
+	}
+
+	inline auto business_day_series::size_in_bytes() const noexcept -> std::size_t
+	{
+		return _values.size() * sizeof(double) + _valid.size() * sizeof(std::uint64_t);
+	}
+
+
+	inline auto business_day_series::_slot(const std::chrono::year_month_day& ymd) const -> std::optional<std::size_t>
+	{
+		if (ymd < _period.get_from() || ymd > _period.get_until() || !_publication->is_business_day(ymd))
+			return std::nullopt;
+
+		return _publication->business_day_ordinal(ymd) - _first;
+	}
+
+	inline auto business_day_series::_is_valid(const std::size_t slot) const noexcept -> bool
+	{
+		return (_valid[slot / 64u] >> (slot % 64u)) & 1u;
+	}
+
+}
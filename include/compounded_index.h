@@ -22,6 +22,13 @@
 
 #pragma once
 
+#include "accrual_factors.h"
+#include "business_day_series.h"
+#include "compounding_conventions.h"
+#include "instrumentation.h"
+#include "dense_calendar.h"
+#include "serial_date.h"
+
 #include <round.h>
 #include <resets.h>
 
@@ -34,109 +41,555 @@
 
 #include <chrono>
 #include <memory>
+#include <vector>
+#include <deque>
+#include <optional>
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+#include <execution>
+#include <type_traits>
+#include <cstddef>
 
 
 namespace risk_free_rate
 {
 
-	inline auto make_compounded_index( // should it be make_compounded_index_resets?
-		const resets& r,
-		std::chrono::year_month_day from,
-		const gregorian::calendar& publication,
-		const unsigned decimal_places,
-		const double starting_value = 100.0 // alternatively we can rebalance everything for 1.0
-	) -> resets
+	// running state of a compounded index, which is enough to extend the index when new resets arrive
+	// (unrounded for make_compounded_index, the same as published for make_compounded_index2)
+	struct compounded_index_state
 	{
-		// for now we assume that "from" exists in r (which is probably what all real cases do)
+		std::chrono::year_month_day _date; // maturity of the last reset participating in the index
+		double _index;
+	};
+
+
+	// grows the running index by a daily factor and gives the value to publish
+	template<rounding Rounding>
+	auto _compound_index_step(double& index, const double factor, const unsigned decimal_places) -> double
+	{
+		index *= factor;
+
+		if constexpr (Rounding == rounding::every_step)
+		{
+			index = _round(index, decimal_places); // is this special to SARON only?
 
+			// I need to find a better way of handling "not a rate" resets (at the moment we mix together rates and indices, which is not clean)
+			return index;
+		}
+		else
+		{
+			return _round(index, decimal_places);
+			// I also read it as "only the final result is rounded" (no rounding on each step of the calculation)
+		}
+	}
+
+
+	// extends the index in result (resets::storage or business_day_series) from state up to the maturity of the last reset
+	template<rounding Rounding, typename DayCount, typename Series, publication_calendar Calendar>
+	auto _extend_compounded_index(
+		const DayCount& day_count,
+		Series& result,
+		compounded_index_state& state,
+		const resets& r,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> void
+	{
 		// at the moment we do not protect against resets (incorrectly) provided for non-business days
 		// (they are just ignored in these calculations)
 		// is this an issue for the last reset?
 
+		const auto last_reset = to_serial(r.last_reset_year_month_day());
+
+		for (auto d = _make_business_day(state._date); d._serial <= last_reset;)
+		{
+			const auto effective = d;
+			const auto maturity = _make_overnight_maturity(d, publication);
+			const auto year_fraction = day_count.fraction(effective._serial, maturity._serial);
+
+			result[maturity._ymd] = _compound_index_step<Rounding>(
+				state._index,
+				_growth(day_count, r[effective._ymd], year_fraction),
+				decimal_places
+			);
+
+			state._date = maturity._ymd;
+
+			d = maturity;
+		}
+	}
+
+	// the same as above, but from daily factors which were calculated already
+	// (up to the last date of the factors, state._date should be one of their dates)
+	template<rounding Rounding, typename Series>
+	auto _extend_compounded_index(
+		const accrual_factors& factors,
+		Series& result,
+		compounded_index_state& state,
+		const unsigned decimal_places
+	) -> void
+	{
+		const auto& dates = factors.get_dates();
+		const auto& f = factors.get_factors();
+
+		for (auto i = factors.slot(state._date); i < f.size(); ++i)
+		{
+			result[dates[i + 1u]] = _compound_index_step<Rounding>(state._index, f[i], decimal_places);
+
+			state._date = dates[i + 1u];
+		}
+	}
+
+
+	template<rounding Rounding, typename DayCount, publication_calendar Calendar>
+	auto _make_compounded_index(
+		const DayCount& day_count,
+		const resets& r,
+		compounded_index_state& state,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> resets
+	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_index };
+
+		// for now we assume that "from" exists in r (which is probably what all real cases do)
+
 		const auto& last_reset_ymd = r.last_reset_year_month_day();
 
+		// is this correct for "Swiss Current Rate ON" as well?
 		// resets are stored based on effective date of the rate (not a publication date, which is the next business day)
 		// but compounded index is published for the maturity of the last rate participating in the calculation of the index
 		// hence we need to use publication_calendar to add 1 business day to the latest reset date
-		auto until = coupon_schedule::make_overnight_maturity(last_reset_ymd, publication);
+		auto until = _make_overnight_maturity(last_reset_ymd, publication);
 
-		auto from_until = gregorian::days_period{ std::move(from), std::move(until) };
+		auto from_until = gregorian::days_period{ state._date, std::move(until) };
 
 		auto result = resets::storage{ std::move(from_until) };
 
-		const auto day_count = r.get_day_count();
+		result[state._date] = state._index;
 
-		auto index = starting_value;
-		result[from] = index;
+		_extend_compounded_index<Rounding>(day_count, result, state, r, publication, decimal_places);
 
-		for (auto d = from; d <= last_reset_ymd;)
+		const auto resets_day_count = r.get_day_count();
+
+		return resets{ std::move(result), resets_day_count }; // we assume that resets day count and index day count are the same
+	}
+
+	template<rounding Rounding, publication_calendar Calendar>
+	auto _make_compounded_index(
+		const resets& r,
+		compounded_index_state& state,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> resets
+	{
+		return _visit_day_count(
+			r.get_day_count(),
+			[&](const auto& day_count) { return _make_compounded_index<Rounding>(day_count, r, state, publication, decimal_places); }
+		);
+	}
+
+
+	// compounded index which can be extended in place
+	// (so that appending the resets of a day does not touch the rest of the history -
+	// the values are kept in a deque, which grows at the end without moving what is already there)
+	class compounded_index_series final
+	{
+
+	public:
+
+		// copies the index (once, after that only the new days are added)
+		explicit compounded_index_series(const resets& index);
+
+	public:
+
+		// nothing outside of the period
+		auto operator[](const std::chrono::year_month_day& ymd) const -> std::optional<double>;
+
+		// grows the series if ymd is after the end of the period
+		auto operator[](const std::chrono::year_month_day& ymd) -> std::optional<double>&;
+
+		auto get_period() const -> gregorian::days_period;
+		auto get_day_count() const noexcept -> const coupon_schedule::day_count*;
+
+		auto to_resets() const -> resets;
+
+	private:
+
+		serial_date _from;
+		std::deque<std::optional<double>> _values;
+		const coupon_schedule::day_count* _day_count;
+
+	};
+
+
+	inline compounded_index_series::compounded_index_series(const resets& index) :
+		_from{ to_serial(index.get_time_series().get_period().get_from()) },
+		_values{},
+		_day_count{ index.get_day_count() }
+	{
+		const auto& ts = index.get_time_series();
+		for (auto d = std::chrono::sys_days{ ts.get_period().get_from() }; d <= std::chrono::sys_days{ ts.get_period().get_until() }; d += std::chrono::days{ 1 })
+			_values.push_back(ts[d]);
+	}
+
+	inline auto compounded_index_series::operator[](const std::chrono::year_month_day& ymd) const -> std::optional<double>
+	{
+		const auto d = to_serial(ymd);
+		if (d < _from || static_cast<std::size_t>(d - _from) >= _values.size())
+			return std::nullopt;
+
+		return _values[static_cast<std::size_t>(d - _from)];
+	}
+
+	inline auto compounded_index_series::operator[](const std::chrono::year_month_day& ymd) -> std::optional<double>&
+	{
+		const auto d = to_serial(ymd);
+		if (d < _from)
+			throw std::out_of_range{ "Date is before the compounded index" };
+
+		const auto i = static_cast<std::size_t>(d - _from);
+		if (i >= _values.size())
+			_values.resize(i + 1u);
+
+		return _values[i];
+	}
+
+	inline auto compounded_index_series::get_period() const -> gregorian::days_period
+	{
+		return { from_serial(_from), from_serial(_from + static_cast<serial_date>(_values.size()) - 1) };
+	}
+
+	inline auto compounded_index_series::get_day_count() const noexcept -> const coupon_schedule::day_count*
+	{
+		return _day_count;
+	}
+
+	inline auto compounded_index_series::to_resets() const -> resets
+	{
+		auto result = resets::storage{ get_period() };
+
+		auto d = std::chrono::sys_days{ from_serial(_from) };
+		for (const auto& v : _values)
 		{
-			const auto effective = d;
-			const auto maturity = coupon_schedule::make_overnight_maturity(d, publication);
-			const auto year_fraction = day_count->fraction({ effective, maturity });
+			result[d] = v;
+			d += std::chrono::days{ 1 };
+		}
 
-			index *= 1.0 + r[effective] * year_fraction;
+		return resets{ std::move(result), _day_count };
+	}
 
-			// I need to find a better way of handling "not a rate" resets (at the moment we mix together rates and indices, which is not clean)
-			result[maturity] = round(index, decimal_places);
-			// I also read it as "only the final result is rounded" (no rounding on each step of the calculation)
 
-			d = maturity;
+	// extends the index in place with the new resets (from the state onwards)
+	template<rounding Rounding, publication_calendar Calendar>
+	auto _append_compounded_index(
+		compounded_index_series& index,
+		compounded_index_state& state,
+		const resets& r,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> void
+	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_index };
+
+		_visit_day_count(
+			r.get_day_count(),
+			[&](const auto& day_count) { _extend_compounded_index<Rounding>(day_count, index, state, r, publication, decimal_places); }
+		);
+	}
+
+
+	template<publication_calendar Calendar>
+	auto make_compounded_index( // should it be make_compounded_index_resets?
+		const resets& r,
+		std::chrono::year_month_day from,
+		const Calendar& publication,
+		const unsigned decimal_places,
+		const double starting_value = 100.0 // alternatively we can rebalance everything for 1.0
+	) -> resets
+	{
+		auto state = compounded_index_state{ std::move(from), starting_value };
+
+		return _make_compounded_index<rounding::output_only>(r, state, publication, decimal_places);
+	}
+
+	// the same as above, but starts from the state and leaves it at the end of the index
+	// (so the index can be extended later with append_compounded_index)
+	template<publication_calendar Calendar>
+	auto make_compounded_index(
+		const resets& r,
+		compounded_index_state& state,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> resets
+	{
+		return _make_compounded_index<rounding::output_only>(r, state, publication, decimal_places);
+	}
+
+	// extends the index with new resets (only resets from state._date onwards are needed)
+	// in the same way as a full rebuild with make_compounded_index would do
+	// (the cost depends only on the number of new days)
+	template<publication_calendar Calendar>
+	auto append_compounded_index(
+		compounded_index_series& index,
+		compounded_index_state& state,
+		const resets& r,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> void
+	{
+		_append_compounded_index<rounding::output_only>(index, state, r, publication, decimal_places);
+	}
+
+
+	// chunks of the parallel scan below (fixed, so the result does not depend on the number of threads)
+	constexpr auto _scan_chunk = std::size_t{ 256u };
+
+	// the same as make_compounded_index, but as the running index is not rounded it is just a cumulative product
+	// of the daily factors, which is calculated as a chunked prefix scan according to the execution policy:
+	// the products within each chunk, then the value of the index at the start of each chunk, then the index
+	// (the order of multiplications is different from make_compounded_index, so the unrounded index can differ
+	// in the last couple of bits, which after rounding to 8 decimal places gives the same results on our data)
+	template<typename ExecutionPolicy, publication_calendar Calendar>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	auto make_compounded_index(
+		ExecutionPolicy&& policy,
+		const resets& r,
+		const std::chrono::year_month_day& from,
+		const Calendar& publication,
+		const unsigned decimal_places,
+		const double starting_value = 100.0
+	) -> resets
+	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_index };
+
+		const auto& last_reset_ymd = r.last_reset_year_month_day();
+
+		const auto until = _make_overnight_maturity(last_reset_ymd, publication);
+
+		auto result = resets::storage{ gregorian::days_period{ from, until } };
+
+		// each date depends on the previous one, so the grid has to be known before we start
+		// (the resets are looked up here as well, as an exception can not leave a parallel algorithm)
+		auto dates = std::vector<_business_day>{};
+		auto rates = std::vector<double>{};
+		for (auto d = _make_business_day(from); d._ymd <= until; d = _make_overnight_maturity(d, publication))
+		{
+			dates.push_back(d);
+			if (d._ymd < until)
+				rates.push_back(r[d._ymd]);
 		}
 
-		return resets{ std::move(result), day_count }; // we assume that resets day count and index day count are the same
+		// factors[i] is for the overnight period starting on dates[i], and then becomes the product
+		// of the factors from the start of its chunk up to and including itself
+		auto factors = std::vector<double>(dates.size() - 1u);
+
+		const auto chunks = (factors.size() + _scan_chunk - 1u) / _scan_chunk;
+
+		// the value of the index at the start of each chunk
+		auto offsets = std::vector<double>(chunks + 1u);
+
+		// the algorithms below go over the chunk numbers rather than the elements of the vectors
+		// (a parallel algorithm can work on copies of the elements, so their addresses can not be relied on)
+		auto chunk_numbers = std::vector<std::size_t>(chunks);
+		std::iota(chunk_numbers.begin(), chunk_numbers.end(), std::size_t{ 0u });
+
+		_visit_day_count(
+			r.get_day_count(),
+			[&](const auto& day_count)
+			{
+				std::for_each(
+					policy,
+					chunk_numbers.cbegin(),
+					chunk_numbers.cend(),
+					[&](const std::size_t c)
+					{
+						const auto chunk_from = c * _scan_chunk;
+						const auto chunk_until = std::min(chunk_from + _scan_chunk, factors.size());
+
+						auto product = 1.0;
+						for (auto i = chunk_from; i < chunk_until; ++i)
+						{
+							const auto year_fraction = day_count.fraction(dates[i]._serial, dates[i + 1u]._serial);
+
+							product *= _growth(day_count, rates[i], year_fraction);
+
+							factors[i] = product;
+						}
+					}
+				);
+			}
+		);
+
+		offsets.front() = starting_value;
+		for (auto c = std::size_t{ 0u }; c < chunks; ++c)
+			offsets[c + 1u] = offsets[c] * factors[std::min((c + 1u) * _scan_chunk, factors.size()) - 1u];
+
+		result[from] = starting_value;
+
+		std::for_each(
+			std::forward<ExecutionPolicy>(policy),
+			chunk_numbers.cbegin(),
+			chunk_numbers.cend(),
+			[&](const std::size_t c)
+			{
+				const auto chunk_from = c * _scan_chunk;
+				const auto chunk_until = std::min(chunk_from + _scan_chunk, factors.size());
+
+				for (auto i = chunk_from; i < chunk_until; ++i)
+					result[dates[i + 1u]._ymd] = _round(offsets[c] * factors[i], decimal_places);
+			}
+		);
+
+		const auto resets_day_count = r.get_day_count();
+
+		return resets{ std::move(result), resets_day_count }; // we assume that resets day count and index day count are the same
 	}
 
 
 	// this needs further investigation (and a better name)
-	inline auto make_compounded_index2(
+	template<publication_calendar Calendar>
+	auto make_compounded_index2(
 		const resets& r,
 		std::chrono::year_month_day from,
-		const gregorian::calendar& publication,
+		const Calendar& publication,
 		const unsigned decimal_places,
 		const double starting_value = 100.0 // alternatively we can rebalance everything for 1.0
 	) -> resets
 	{
-		// for now we assume that "from" exists in r (which is probably what all real cases do)
+		auto state = compounded_index_state{ std::move(from), starting_value };
 
-		// at the moment we do not protect against resets (incorrectly) provided for non-business days
-		// (they are just ignored in these calculations)
-		// is this an issue for the last reset?
+		return _make_compounded_index<rounding::every_step>(r, state, publication, decimal_places);
+	}
+
+	template<publication_calendar Calendar>
+	auto make_compounded_index2(
+		const resets& r,
+		compounded_index_state& state,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> resets
+	{
+		return _make_compounded_index<rounding::every_step>(r, state, publication, decimal_places);
+	}
+
+	// as the index is rounded on every step, the state is just the last published value
+	template<publication_calendar Calendar>
+	auto append_compounded_index2(
+		compounded_index_series& index,
+		compounded_index_state& state,
+		const resets& r,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> void
+	{
+		_append_compounded_index<rounding::every_step>(index, state, r, publication, decimal_places);
+	}
+
+
+	// compounded index according to the benchmark's convention, for example
+	// make_compounded_index(SARONCompoundedIndexConvention, r, from, publication, 10'000.0)
+	// (throws if the day count of the resets is not the one of the convention)
+	template<index_convention Convention, publication_calendar Calendar>
+	auto make_compounded_index(
+		const Convention& convention,
+		const resets& r,
+		std::chrono::year_month_day from,
+		const Calendar& publication,
+		const double starting_value = 100.0
+	) -> resets
+	{
+		_check_day_count(convention, r.get_day_count());
+
+		auto state = compounded_index_state{ std::move(from), starting_value };
+
+		return _make_compounded_index<Convention::rounding_policy>(
+			typename Convention::day_count{},
+			r,
+			state,
+			publication,
+			Convention::decimal_places
+		);
+	}
+
+
+	// the same as above, but only business days are stored (see business_day_series)
+	// (the dense calendar should cover the period from "from" to the maturity of the last reset)
+	template<index_convention Convention>
+	auto make_compounded_index_series(
+		const Convention& convention,
+		const resets& r,
+		std::chrono::year_month_day from,
+		const dense_calendar& publication,
+		const double starting_value = 100.0
+	) -> business_day_series
+	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_index };
+
+		_check_day_count(convention, r.get_day_count());
+
+		auto state = compounded_index_state{ std::move(from), starting_value };
 
 		const auto& last_reset_ymd = r.last_reset_year_month_day();
 
-		// is this correct for "Swiss Current Rate ON" as well?
-		// resets are stored based on effective date of the rate (not a publication date, which is the next business day)
-		// but compounded index is published for the maturity of the last rate participating in the calculation of the index
-		// hence we need to use publication_calendar to add 1 business day to the latest reset date
-		auto until = coupon_schedule::make_overnight_maturity(last_reset_ymd, publication);
+		auto until = _make_overnight_maturity(last_reset_ymd, publication);
 
-		auto from_until = gregorian::days_period{ std::move(from), std::move(until) };
+		auto result = business_day_series{ publication, gregorian::days_period{ state._date, std::move(until) } };
 
-		auto result = resets::storage{ std::move(from_until) };
+		result[state._date] = state._index;
+
+		_extend_compounded_index<Convention::rounding_policy>(
+			typename Convention::day_count{},
+			result,
+			state,
+			r,
+			publication,
+			Convention::decimal_places
+		);
 
-		const auto day_count = r.get_day_count();
+		return result;
+	}
 
-		auto index = starting_value;
-		result[from] = index;
 
-		for (auto d = from; d <= last_reset_ymd;)
-		{
-			const auto effective = d;
-			const auto maturity = coupon_schedule::make_overnight_maturity(d, publication);
-			const auto year_fraction = day_count->fraction({ effective, maturity });
+	// the same as make_compounded_index and make_compounded_index2, but reuses daily factors which were calculated already
+	// (the index starts from the first date of the factors)
+	template<rounding Rounding>
+	auto _make_compounded_index(
+		const accrual_factors& factors,
+		const unsigned decimal_places,
+		const double starting_value
+	) -> resets
+	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_index };
 
-			index *= 1.0 + r[effective] * year_fraction;
+		auto state = compounded_index_state{ factors.get_dates().front(), starting_value };
 
-			index = round(index, decimal_places); // is this special to SARON only?
+		auto result = resets::storage{ factors.get_period() };
 
-			// I need to find a better way of handling "not a rate" resets (at the moment we mix together rates and indices, which is not clean)
-			result[maturity] = index;
+		result[state._date] = state._index;
 
-			d = maturity;
-		}
+		_extend_compounded_index<Rounding>(factors, result, state, decimal_places);
 
-		return resets{ std::move(result), day_count }; // we assume that resets day count and index day count are the same
+		return resets{ std::move(result), factors.get_day_count() };
+	}
+
+	inline auto make_compounded_index(
+		const accrual_factors& factors,
+		const unsigned decimal_places,
+		const double starting_value = 100.0
+	) -> resets
+	{
+		return _make_compounded_index<rounding::output_only>(factors, decimal_places, starting_value);
+	}
+
+	inline auto make_compounded_index2(
+		const accrual_factors& factors,
+		const unsigned decimal_places,
+		const double starting_value = 100.0
+	) -> resets
+	{
+		return _make_compounded_index<rounding::every_step>(factors, decimal_places, starting_value);
 	}
 
 }
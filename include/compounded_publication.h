@@ -0,0 +1,210 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include "compounded_rates.h"
+#include "compounding_conventions.h"
+#include "dense_calendar.h"
+#include "instrumentation.h"
+#include "serial_date.h"
+
+#include <round.h>
+#include <resets.h>
+
+#include <period.h>
+
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+
+namespace risk_free_rate
+{
+
+	// everything an administrator publishes for one benchmark on a day
+	struct compounded_publication
+	{
+		resets _index;
+		std::vector<resets> _rates; // in the same order as the tenors of the pipeline
+	};
+
+
+	// produces the compounded index and the compounded rates of all the tenors of a benchmark
+	// in one walk through the resets (so the overnight maturities, year fractions and daily factors
+	// are calculated once, rather than once per make_compounded_index/make_compounded_rate call),
+	// for example for SARON:
+	// publication_pipeline{ SARONCompoundedIndexConvention, tenors, 4u, 10'000.0 }.run(r, from, publication)
+	template<index_convention Convention>
+	class publication_pipeline final
+	{
+
+	public:
+
+		publication_pipeline(
+			const Convention&,
+			std::vector<tenor> tenors,
+			const unsigned rate_decimal_places,
+			const double starting_value = 100.0
+		);
+
+	public:
+
+		// results are the same as make_compounded_index(Convention{}, r, from, publication, starting_value)
+		// and make_compounded_rates(tenors, r, from, publication, rate_decimal_places)
+		// (throws if the day count of the resets is not the one of the convention)
+		template<publication_calendar Calendar>
+		auto run(
+			const resets& r,
+			const std::chrono::year_month_day& from,
+			const Calendar& publication
+		) const -> compounded_publication;
+
+	public:
+
+		auto get_tenors() const noexcept -> const std::vector<tenor>&;
+
+	private:
+
+		std::vector<tenor> _tenors;
+
+		unsigned _rate_decimal_places;
+
+		double _starting_value;
+
+	};
+
+
+	template<index_convention Convention>
+	publication_pipeline<Convention>::publication_pipeline(
+		const Convention&,
+		std::vector<tenor> tenors,
+		const unsigned rate_decimal_places,
+		const double starting_value
+	) :
+		_tenors{ std::move(tenors) },
+		_rate_decimal_places{ rate_decimal_places },
+		_starting_value{ starting_value }
+	{
+	}
+
+
+	template<index_convention Convention>
+	template<publication_calendar Calendar>
+	auto publication_pipeline<Convention>::run(
+		const resets& r,
+		const std::chrono::year_month_day& from,
+		const Calendar& publication
+	) const -> compounded_publication
+	{
+		// the pipeline stands for both builders
+		const auto index_scope = _instrumentation_scope{ instrumented::make_compounded_index };
+		const auto rate_scope = _instrumentation_scope{ instrumented::make_compounded_rate };
+
+		_check_day_count(Convention{}, r.get_day_count());
+
+		const auto day_count = typename Convention::day_count{};
+
+		const auto& last_reset_ymd = r.last_reset_year_month_day();
+
+		const auto until = _make_business_day(_make_overnight_maturity(last_reset_ymd, publication));
+
+		const auto from_until = gregorian::days_period{ from, until._ymd };
+
+		auto index = resets::storage{ from_until };
+		auto rates = std::vector<resets::storage>(_tenors.size(), resets::storage{ from_until });
+
+		// the date grid and the daily factors seen so far
+		// (the rates look back into them, but never past "from")
+		auto dates = std::vector<serial_date>{};
+		auto factors = std::vector<double>{};
+
+		const auto days = until._serial - to_serial(from);
+		dates.reserve(days + 1);
+		factors.reserve(days);
+
+		auto i = _starting_value;
+		index[from] = i;
+		dates.push_back(to_serial(from));
+
+		for (auto d = _make_business_day(from); d._serial < until._serial;)
+		{
+			const auto effective = d;
+			const auto maturity = _make_overnight_maturity(d, publication);
+			const auto year_fraction = day_count.fraction(effective._serial, maturity._serial);
+			const auto factor = _growth(day_count, r[effective._ymd], year_fraction);
+
+			dates.push_back(maturity._serial);
+			factors.push_back(factor);
+
+			// the same as _extend_compounded_index
+			i *= factor;
+			if constexpr (Convention::rounding_policy == rounding::every_step)
+			{
+				i = _round(i, Convention::decimal_places);
+				index[maturity._ymd] = i;
+			}
+			else
+				index[maturity._ymd] = _round(i, Convention::decimal_places);
+
+			// the same as make_compounded_rates (no rate can mature on "from" itself)
+			const auto j = factors.size();
+			for (auto t = std::size_t{ 0u }; t < _tenors.size(); ++t)
+			{
+				const auto tenor_effective = to_serial(_tenors[t].make_effective(maturity._ymd, _get_calendar(publication)));
+
+				if (tenor_effective >= dates.front())
+				{
+					// non-business days are mapped onto the following business day (as in accrual_factors::slot)
+					const auto s = static_cast<std::size_t>(std::lower_bound(dates.cbegin(), dates.cend(), tenor_effective) - dates.cbegin());
+
+					auto c = 1.0;
+					for (auto k = s; k < j; ++k)
+						c *= factors[k];
+
+					const auto rate = _rate(day_count, c, day_count.fraction(tenor_effective, maturity._serial));
+
+					rates[t][maturity._ymd] = _round(to_percent(rate), _rate_decimal_places);
+				}
+			}
+
+			d = maturity;
+		}
+
+		const auto resets_day_count = r.get_day_count(); // we assume that the convention has the same day count
+
+		auto result = compounded_publication{ resets{ std::move(index), resets_day_count }, {} };
+		result._rates.reserve(rates.size());
+		for (auto& s : rates)
+			result._rates.emplace_back(std::move(s), resets_day_count);
+
+		return result;
+	}
+
+
+	template<index_convention Convention>
+	auto publication_pipeline<Convention>::get_tenors() const noexcept -> const std::vector<tenor>&
+	{
+		return _tenors;
+	}
+
+}
@@ -22,6 +22,13 @@
 
 #pragma once
 
+#include "accrual_factors.h"
+#include "business_day_series.h"
+#include "compounding_conventions.h"
+#include "compounding_range.h"
+#include "instrumentation.h"
+#include "dense_calendar.h"
+
 #include <round.h>
 #include <resets.h>
 
@@ -35,6 +42,15 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
+#include <vector>
+#include <algorithm>
+#include <ranges>
+#include <execution>
+#include <type_traits>
+#include <utility>
+#include <iterator>
+#include <cstddef>
 
 
 namespace risk_free_rate
@@ -63,6 +79,8 @@ namespace risk_free_rate
 		const gregorian::calendar& publication
 	) -> std::chrono::year_month_day
 	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup }; // the rest is trivial (so we time the whole function)
+
 		auto result = effective + term;
 
 		result = _make_ok(result);
@@ -80,6 +98,8 @@ namespace risk_free_rate
 		const gregorian::calendar& publication
 	) -> std::chrono::year_month_day
 	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
 		auto result = std::chrono::year_month_day{
 			std::chrono::sys_days{ effective } + term
 		};
@@ -97,6 +117,8 @@ namespace risk_free_rate
 		const gregorian::calendar& publication
 	) -> std::chrono::year_month_day
 	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
 		auto result = maturity - term;
 
 		result = _make_ok(result);
@@ -114,6 +136,8 @@ namespace risk_free_rate
 		const gregorian::calendar& publication
 	) -> std::chrono::year_month_day
 	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
 		auto result = std::chrono::year_month_day{
 			std::chrono::sys_days{ maturity } - term
 		};
@@ -131,21 +155,47 @@ namespace risk_free_rate
 
 	// should it be implemented via recursion as well? (so we can add one more priod if needed)
 	// (this might help with the index calcuation as well)
-	inline auto compound(const coupon_schedule::compounding_periods& periods, const resets& resets) -> double
+	template<typename DayCount, typename Periods>
+	auto _compound(const DayCount& dc, const Periods& periods, const resets& resets) -> double
 	{
-		const auto dc = resets.get_day_count();
+		// works for the materialised schedule and for compounding_range alike
+		// (the last period is not known in advance for the latter)
+		const auto from = (*std::ranges::begin(periods))._period.get_from();
+		auto until = from;
 
 		auto c = 1.0;
 		for (const auto& p : periods)
-			c *= 1.0 + resets[p._reset] * dc->fraction(p._period);
+		{
+			c *= _growth(dc, resets[p._reset], dc.fraction(p._period));
+			until = p._period.get_until();
+		}
 
-		const auto full_period = gregorian::period{
-			periods.front()._period.get_from(),
-			periods.back()._period.get_until()
-		};
+		const auto full_period = gregorian::period{ from, until };
 		// does it work for degenerate compounding schedules?
 
-		return (c - 1.0) / dc->fraction(full_period);
+		return _rate(dc, c, dc.fraction(full_period));
+	}
+
+	inline auto compound(const coupon_schedule::compounding_periods& periods, const resets& resets) -> double
+	{
+		const auto scope = _instrumentation_scope{ instrumented::compound };
+
+		return _visit_day_count(
+			resets.get_day_count(),
+			[&](const auto& dc) { return _compound(dc, periods, resets); }
+		);
+	}
+
+	// the same as above, but the periods are generated on the fly (no allocations)
+	template<publication_calendar Calendar>
+	auto compound(const compounding_range<Calendar>& periods, const resets& resets) -> double
+	{
+		const auto scope = _instrumentation_scope{ instrumented::compound };
+
+		return _visit_day_count(
+			resets.get_day_count(),
+			[&](const auto& dc) { return _compound(dc, periods, resets); }
+		);
 	}
 	// maybe to move the average through time we can also undo an oldest period and then add a 1 new
 	// (but would it be the same thing numerically?)
@@ -155,52 +205,488 @@ namespace risk_free_rate
 
 
 
-	template<typename T>
+	// compounded rate for a single window, which ends on the maturity
+	// (nothing if the window starts before "from")
+	template<typename T, publication_calendar Calendar>
+	auto _make_compounded_rate(
+		const std::chrono::year_month_day& maturity,
+		const T& term,
+		const resets& r,
+		const std::chrono::year_month_day& from,
+		const gregorian::business_day_convention* const convention,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> std::optional<double>
+	{
+		const auto effective = make_effective(
+			maturity,
+			term,
+			convention,
+			_get_calendar(publication)
+		);
+
+		if (effective >= from) // this also means that we can have resets "from" well in advance of actual first reset
+		{
+			// the same periods as make_compounding_schedule would give for { { effective, maturity }, maturity, maturity },
+			// but without allocating them for every window
+			const auto rate = compound(compounding_range{ effective, maturity, publication }, r);
+
+			return _round(to_percent(rate), decimal_places);
+			// from_percent/to_percent - too fragile? (should it be in the parser only?)
+			// maybe resets is in %, but some view on that is what we need for calcs?
+			// (also optinal in resets and NaN in the view?)
+		}
+		else
+		{
+			return std::nullopt;
+		}
+	}
+
+
+	template<typename T, publication_calendar Calendar>
 	auto make_compounded_rate( // should it be make_compounded_rate_resets?
 		const T& term,
 		const resets& r,
 		std::chrono::year_month_day from,
 		const gregorian::business_day_convention* const convention,
-		const gregorian::calendar& publication,
+		const Calendar& publication,
 		const unsigned decimal_places
 	) -> resets
 	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_rate };
+
 		const auto& last_reset_ymd = r.last_reset_year_month_day();
 
-		auto until = coupon_schedule::make_overnight_maturity(last_reset_ymd, publication);
+		auto until = _make_overnight_maturity(last_reset_ymd, publication);
 
 		auto from_until = gregorian::days_period{ std::move(from), std::move(until) };
 
 		auto result = resets::storage{ std::move(from_until) };
 
-		for (auto d = from; d <= until; d = coupon_schedule::make_overnight_maturity(d, publication))
-		{
-			const auto effective = make_effective(
+		for (auto d = from; d <= until; d = _make_overnight_maturity(d, publication))
+			result[d] = _make_compounded_rate(
 				d,
 				term,
+				r,
+				from,
 				convention,
-				publication
+				publication,
+				decimal_places
 			);
-			const auto maturity = d;
 
-			if (effective >= from) // this also means that we can have resets "from" well in advance of actual first reset
-			{
-				const auto coupon_period = coupon_schedule::coupon_period{ { effective, maturity }, maturity, maturity };
+		const auto resets_day_count = r.get_day_count();
+
+		return resets{ std::move(result), resets_day_count }; // we assume that resets day count and rate day count are the same
+	}
 
-				const auto schedule = coupon_schedule::make_compounding_schedule(coupon_period, publication);
 
-				const auto rate = compound(schedule, r);
+	// the same as above, but the windows are calculated according to the execution policy (in parallel for example)
+	// and the results are written into the storage provided (resets::storage or business_day_series),
+	// which should already cover the period from "from" to the maturity of the last reset
+	template<typename ExecutionPolicy, typename T, publication_calendar Calendar, typename Series>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	auto make_compounded_rate(
+		ExecutionPolicy&& policy,
+		const T& term,
+		const resets& r,
+		const std::chrono::year_month_day& from,
+		const gregorian::business_day_convention* const convention,
+		const Calendar& publication,
+		const unsigned decimal_places,
+		Series& result
+	) -> void
+	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_rate };
+
+		const auto& last_reset_ymd = r.last_reset_year_month_day();
 
-				result[maturity] = round(to_percent(rate), decimal_places);
-				// from_percent/to_percent - too fragile? (should it be in the parser only?)
-				// maybe resets is in %, but some view on that is what we need for calcs?
-				// (also optinal in resets and NaN in the view?)
+		const auto until = _make_overnight_maturity(last_reset_ymd, publication);
+
+		// each date depends on the previous one, so the grid has to be known before we start
+		// (the storage is checked to cover it here as well, as an exception can not leave a parallel algorithm)
+		auto maturities = std::vector<std::chrono::year_month_day>{};
+		for (auto d = from; d <= until; d = _make_overnight_maturity(d, publication))
+		{
+			static_cast<void>(result[d]);
+			maturities.push_back(d);
+		}
+
+		// for the same reason the resets are checked to be there for all the published windows
+		// (the effective dates do not go backwards, so these are the business days from the first published one)
+		for (const auto& maturity : maturities)
+		{
+			const auto effective = make_effective(maturity, term, convention, _get_calendar(publication));
+			if (effective >= from)
+			{
+				for (const auto& d : maturities)
+					if (d >= effective && d < until)
+						static_cast<void>(r[d]);
+
+				break;
 			}
 		}
 
-		const auto resets_day_count = r.get_day_count();
+		// each window is written into its own slot, so the result does not depend on the order of calculations
+		std::for_each(
+			std::forward<ExecutionPolicy>(policy),
+			maturities.cbegin(),
+			maturities.cend(),
+			[&](const std::chrono::year_month_day& maturity)
+			{
+				result[maturity] = _make_compounded_rate(
+					maturity,
+					term,
+					r,
+					from,
+					convention,
+					publication,
+					decimal_places
+				);
+			}
+		);
+	}
 
-		return resets{ std::move(result), resets_day_count }; // we assume that resets day count and rate day count are the same
+
+	// the same as make_compounded_rate, but only business days are stored (see business_day_series)
+	// (the dense calendar should cover the period from "from" to the maturity of the last reset)
+	template<typename T>
+	auto make_compounded_rate_series(
+		const T& term,
+		const resets& r,
+		const std::chrono::year_month_day& from,
+		const gregorian::business_day_convention* const convention,
+		const dense_calendar& publication,
+		const unsigned decimal_places
+	) -> business_day_series
+	{
+		const auto& last_reset_ymd = r.last_reset_year_month_day();
+
+		auto until = _make_overnight_maturity(last_reset_ymd, publication);
+
+		auto result = business_day_series{ publication, gregorian::days_period{ from, std::move(until) } };
+
+		make_compounded_rate(
+			std::execution::seq,
+			term,
+			r,
+			from,
+			convention,
+			publication,
+			decimal_places,
+			result
+		);
+
+		return result;
+	}
+
+
+
+	// a single compounded rate, as make_compounded_rate would publish it for the maturity
+	// (only the window itself is compounded, so this costs the same for a rate from 2000 as for one from yesterday)
+	// nothing if make_compounded_rate would not publish a rate for the maturity: it is not a business day,
+	// it is after the maturity of the last reset or the window starts before the first day of the resets
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_at(
+		const std::chrono::year_month_day& maturity,
+		const T& term,
+		const gregorian::business_day_convention* const convention,
+		const Calendar& publication,
+		const resets& r,
+		const unsigned decimal_places
+	) -> std::optional<double>
+	{
+		if (!_get_calendar(publication).is_business_day(maturity))
+			return std::nullopt;
+
+		if (maturity > _make_overnight_maturity(r.last_reset_year_month_day(), publication))
+			return std::nullopt;
+
+		return _make_compounded_rate(
+			maturity,
+			term,
+			r,
+			r.get_time_series().get_period().get_from(),
+			convention,
+			publication,
+			decimal_places
+		);
+	}
+
+
+	// the same rates as make_compounded_rate gives, but each one is only calculated when the iterator is dereferenced
+	// (so taking a few of them, or skipping to a date, does not compound the whole history)
+	// the resets and the calendar are not owned, so they should outlive the view
+	template<typename T, publication_calendar Calendar>
+	class compounded_rate_view final : public std::ranges::view_interface<compounded_rate_view<T, Calendar>>
+	{
+
+	public:
+
+		class iterator final
+		{
+
+		public:
+
+			using value_type = std::pair<std::chrono::year_month_day, std::optional<double>>;
+			using difference_type = std::ptrdiff_t;
+
+		public:
+
+			iterator() noexcept = default;
+
+			explicit iterator(
+				const compounded_rate_view* view,
+				const std::chrono::year_month_day& maturity
+			) noexcept;
+
+		public:
+
+			auto operator*() const -> value_type;
+
+			auto operator++() -> iterator&;
+			auto operator++(int) -> iterator;
+
+			// without calculating the rate
+			auto get_maturity() const noexcept -> const std::chrono::year_month_day&;
+
+			friend auto operator==(const iterator& i, const iterator& j) noexcept -> bool
+			{
+				return i._maturity == j._maturity;
+			}
+
+			friend auto operator==(const iterator& i, std::default_sentinel_t) noexcept -> bool
+			{
+				return i._done();
+			}
+
+		private:
+
+			auto _done() const noexcept -> bool;
+
+		private:
+
+			const compounded_rate_view* _view{ nullptr };
+			std::chrono::year_month_day _maturity{};
+
+		};
+
+	public:
+
+		compounded_rate_view() noexcept = default;
+
+		explicit compounded_rate_view(
+			T term,
+			const resets& r,
+			std::chrono::year_month_day from,
+			const gregorian::business_day_convention* const convention,
+			const Calendar& publication,
+			const unsigned decimal_places
+		);
+
+	public:
+
+		auto begin() const noexcept -> iterator;
+		auto end() const noexcept -> std::default_sentinel_t;
+
+		// the rest of the view from the first maturity on or after the date
+		// (only the calendar is walked to get there, nothing is compounded)
+		// (the iterators point back to the view, so not on a temporary)
+		auto starting_at(const std::chrono::year_month_day& maturity) const& -> std::ranges::subrange<iterator, std::default_sentinel_t>;
+		auto starting_at(const std::chrono::year_month_day& maturity) const&& -> std::ranges::subrange<iterator, std::default_sentinel_t> = delete;
+
+	private:
+
+		T _term{};
+		const resets* _resets{ nullptr };
+		std::chrono::year_month_day _from{};
+		std::chrono::year_month_day _until{}; // maturity of the last reset
+		const gregorian::business_day_convention* _convention{ nullptr };
+		const Calendar* _publication{ nullptr };
+		unsigned _decimal_places{ 0u };
+
+	};
+
+
+	template<typename T, publication_calendar Calendar>
+	compounded_rate_view<T, Calendar>::iterator::iterator(
+		const compounded_rate_view* view,
+		const std::chrono::year_month_day& maturity
+	) noexcept :
+		_view{ view },
+		_maturity{ maturity }
+	{
+	}
+
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_view<T, Calendar>::iterator::operator*() const -> value_type
+	{
+		return {
+			_maturity,
+			_make_compounded_rate(
+				_maturity,
+				_view->_term,
+				*_view->_resets,
+				_view->_from,
+				_view->_convention,
+				*_view->_publication,
+				_view->_decimal_places
+			)
+		};
+	}
+
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_view<T, Calendar>::iterator::operator++() -> iterator&
+	{
+		_maturity = _make_overnight_maturity(_maturity, *_view->_publication);
+
+		return *this;
+	}
+
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_view<T, Calendar>::iterator::operator++(int) -> iterator
+	{
+		auto result = *this;
+		++*this;
+
+		return result;
+	}
+
+
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_view<T, Calendar>::iterator::get_maturity() const noexcept -> const std::chrono::year_month_day&
+	{
+		return _maturity;
+	}
+
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_view<T, Calendar>::iterator::_done() const noexcept -> bool
+	{
+		// a default constructed iterator (as forward_range requires them) does not point to any view
+		return !_view || _maturity > _view->_until;
+	}
+
+
+	template<typename T, publication_calendar Calendar>
+	compounded_rate_view<T, Calendar>::compounded_rate_view(
+		T term,
+		const resets& r,
+		std::chrono::year_month_day from,
+		const gregorian::business_day_convention* const convention,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) :
+		_term{ std::move(term) },
+		_resets{ &r },
+		_from{ std::move(from) },
+		_until{ _make_overnight_maturity(r.last_reset_year_month_day(), publication) },
+		_convention{ convention },
+		_publication{ &publication },
+		_decimal_places{ decimal_places }
+	{
+	}
+
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_view<T, Calendar>::begin() const noexcept -> iterator
+	{
+		return iterator{ this, _from };
+	}
+
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_view<T, Calendar>::end() const noexcept -> std::default_sentinel_t
+	{
+		return std::default_sentinel;
+	}
+
+	template<typename T, publication_calendar Calendar>
+	auto compounded_rate_view<T, Calendar>::starting_at(const std::chrono::year_month_day& maturity) const& -> std::ranges::subrange<iterator, std::default_sentinel_t>
+	{
+		auto i = begin();
+		while (i != end() && i.get_maturity() < maturity)
+			++i;
+
+		return { i, end() };
+	}
+
+	// the rolling version below accumulates a couple of ulps of error in the running product on each step
+	// (by dividing out the periods which fall off the window), so every so often we compound the window from scratch
+	// (exactly as compound() does) - this keeps the relative error of the compounded factor below
+	// 2 * _rolling_refresh * epsilon (around 3e-14), which means that after rounding to 4-5 decimal places
+	// we get the same result as make_compounded_rate, unless the rate is within ~1e-10 of a rounding boundary
+	constexpr auto _rolling_refresh = 64u;
+
+	template<typename T, publication_calendar Calendar>
+	auto make_compounded_rate_rolling(
+		const T& term,
+		const resets& r,
+		std::chrono::year_month_day from,
+		const gregorian::business_day_convention* const convention,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> resets
+	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_rate };
+
+		// each daily factor is calculated only once, rather than once for every window it participates in
+		const auto factors = accrual_factors{ r, from, publication };
+		const auto& dates = factors.get_dates();
+		const auto& f = factors.get_factors();
+
+		const auto day_count = factors.get_day_count();
+
+		auto result = resets::storage{ factors.get_period() };
+
+		// c is the product of factors in [lo, hi) - the previous window
+		auto lo = std::size_t{ 0u };
+		auto hi = std::size_t{ 0u };
+		auto c = 1.0;
+		auto steps = 0u;
+
+		for (auto j = std::size_t{ 0u }; j < dates.size(); ++j)
+		{
+			const auto maturity = dates[j];
+			const auto effective = make_effective(
+				maturity,
+				term,
+				convention,
+				_get_calendar(publication)
+			);
+
+			if (effective >= from)
+			{
+				const auto i = factors.slot(effective);
+
+				if (i >= hi || ++steps == _rolling_refresh)
+				{
+					// nothing to reuse from the previous window (or it is time to get rid of the accumulated error)
+					c = 1.0;
+					for (auto k = i; k < j; ++k)
+						c *= f[k];
+
+					steps = 0u;
+				}
+				else
+				{
+					for (auto k = hi; k < j; ++k)
+						c *= f[k];
+					for (auto k = lo; k < i; ++k)
+						c /= f[k];
+					for (auto k = i; k < lo; ++k) // can effective go backwards? (not for the standard conventions)
+						c *= f[k];
+				}
+
+				lo = i;
+				hi = j;
+
+				const auto rate = _visit_day_count(
+					day_count,
+					[&](const auto& dc) { return _rate(dc, c, dc.fraction(to_serial(effective), to_serial(maturity))); }
+				);
+
+				result[maturity] = _round(to_percent(rate), decimal_places);
+			}
+		}
+
+		return resets{ std::move(result), day_count }; // we assume that resets day count and rate day count are the same
 	}
 
 }
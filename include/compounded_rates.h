@@ -0,0 +1,200 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "accrual_factors.h"
+#include "dense_calendar.h"
+#include "compounded_rate.h"
+#include "instrumentation.h"
+#include "inverse_modified_following.h"
+
+#include <round.h>
+#include <resets.h>
+
+#include <period.h>
+#include <time_series.h>
+#include <business_day_convention_interface.h>
+#include <calendar.h>
+
+#include <chrono>
+#include <variant>
+#include <vector>
+#include <cstddef>
+
+
+namespace risk_free_rate
+{
+
+	// term of a compounded rate together with the way its effective date is derived from its maturity
+	class tenor final
+	{
+
+	public:
+
+		tenor(
+			std::chrono::weeks term,
+			const gregorian::business_day_convention* const convention
+		) noexcept;
+
+		tenor(
+			std::chrono::months term,
+			const gregorian::business_day_convention* const convention
+		) noexcept;
+
+		// SARON style, where the convention depends on the maturity (see inverse_modified_following)
+		explicit tenor(std::chrono::months term) noexcept;
+
+		// the same, but with start dates precomputed
+		explicit tenor(const inverse_modified_following_table* const table) noexcept;
+
+	public:
+
+		auto make_effective(
+			const std::chrono::year_month_day& maturity,
+			const gregorian::calendar& publication
+		) const -> std::chrono::year_month_day;
+
+	private:
+
+		std::variant<std::chrono::weeks, std::chrono::months> _term;
+
+		const gregorian::business_day_convention* _convention; // nullptr for inverse_modified_following
+
+		const inverse_modified_following_table* _table;
+
+	};
+
+
+	inline tenor::tenor(
+		std::chrono::weeks term,
+		const gregorian::business_day_convention* const convention
+	) noexcept :
+		_term{ std::move(term) },
+		_convention{ convention },
+		_table{ nullptr }
+	{
+	}
+
+	inline tenor::tenor(
+		std::chrono::months term,
+		const gregorian::business_day_convention* const convention
+	) noexcept :
+		_term{ std::move(term) },
+		_convention{ convention },
+		_table{ nullptr }
+	{
+	}
+
+	inline tenor::tenor(std::chrono::months term) noexcept :
+		_term{ std::move(term) },
+		_convention{ nullptr },
+		_table{ nullptr }
+	{
+	}
+
+	inline tenor::tenor(const inverse_modified_following_table* const table) noexcept :
+		_term{ table->get_term() },
+		_convention{ nullptr },
+		_table{ table }
+	{
+	}
+
+
+	inline auto tenor::make_effective(
+		const std::chrono::year_month_day& maturity,
+		const gregorian::calendar& publication
+	) const -> std::chrono::year_month_day
+	{
+		if (_table)
+			return _table->make_effective(maturity);
+		else if (_convention)
+			return std::visit(
+				[&](const auto& term) { return risk_free_rate::make_effective(maturity, term, _convention, publication); },
+				_term
+			);
+		else
+		{
+			const auto term = std::get<std::chrono::months>(_term);
+			const auto convention = inverse_modified_following{ maturity, term };
+
+			return risk_free_rate::make_effective(maturity, term, &convention, publication);
+		}
+	}
+
+
+
+	// the same as make_compounded_rate for each of the tenors, but the walk through the resets
+	// (and so the overnight maturities and daily factors) is shared between all of them
+	template<publication_calendar Calendar>
+	auto make_compounded_rates(
+		const std::vector<tenor>& tenors,
+		const resets& r,
+		std::chrono::year_month_day from,
+		const Calendar& publication,
+		const unsigned decimal_places
+	) -> std::vector<resets>
+	{
+		const auto scope = _instrumentation_scope{ instrumented::make_compounded_rate };
+
+		const auto factors = accrual_factors{ r, from, publication };
+		const auto& dates = factors.get_dates();
+		const auto& f = factors.get_factors();
+
+		const auto day_count = factors.get_day_count();
+
+		auto storages = std::vector<resets::storage>(tenors.size(), resets::storage{ factors.get_period() });
+
+		for (auto j = std::size_t{ 0u }; j < dates.size(); ++j)
+		{
+			const auto& maturity = dates[j];
+
+			for (auto t = std::size_t{ 0u }; t < tenors.size(); ++t)
+			{
+				const auto effective = tenors[t].make_effective(maturity, _get_calendar(publication));
+
+				if (effective >= from)
+				{
+					// the same order of multiplications as in compound(), so results are the same as make_compounded_rate
+					auto c = 1.0;
+					for (auto i = factors.slot(effective); i < j; ++i)
+						c *= f[i];
+
+					const auto rate = _visit_day_count(
+						day_count,
+						[&](const auto& dc) { return _rate(dc, c, dc.fraction(to_serial(effective), to_serial(maturity))); }
+					);
+
+					storages[t][maturity] = _round(to_percent(rate), decimal_places);
+				}
+			}
+		}
+
+		auto result = std::vector<resets>{};
+		result.reserve(storages.size());
+		for (auto& s : storages)
+			result.emplace_back(std::move(s), day_count); // we assume that resets day count and rate day count are the same
+
+		return result;
+	}
+
+}
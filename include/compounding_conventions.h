@@ -0,0 +1,261 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "bitset_calendar.h"
+#include "instrumentation.h"
+#include "serial_date.h"
+
+#include <day_counts.h>
+
+#include <period.h>
+
+#include <chrono>
+#include <concepts>
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+
+
+namespace risk_free_rate
+{
+
+	// day counts known at compile time, so that the compounding loops do not go through a virtual call for each day
+	// (they have to calculate exactly the same as Actual360 and Actual365Fixed)
+
+	struct actual_360_day_count final
+	{
+		static auto fraction(const gregorian::days_period& p) noexcept -> double
+		{
+			const auto scope = _instrumentation_scope{ instrumented::day_count_fraction };
+
+			const auto days = std::chrono::sys_days{ p.get_until() } - std::chrono::sys_days{ p.get_from() };
+
+			return days.count() / 360.0;
+		}
+
+		static auto fraction(const serial_date from, const serial_date until) noexcept -> double
+		{
+			const auto scope = _instrumentation_scope{ instrumented::day_count_fraction };
+
+			return (until - from) / 360.0;
+		}
+	};
+
+	struct actual_365_fixed_day_count final
+	{
+		static auto fraction(const gregorian::days_period& p) noexcept -> double
+		{
+			const auto scope = _instrumentation_scope{ instrumented::day_count_fraction };
+
+			const auto days = std::chrono::sys_days{ p.get_until() } - std::chrono::sys_days{ p.get_from() };
+
+			return days.count() / 365.0;
+		}
+
+		static auto fraction(const serial_date from, const serial_date until) noexcept -> double
+		{
+			const auto scope = _instrumentation_scope{ instrumented::day_count_fraction };
+
+			return (until - from) / 365.0;
+		}
+	};
+
+	// any other day count
+	struct _dynamic_day_count final
+	{
+		auto fraction(const gregorian::days_period& p) const -> double
+		{
+			const auto scope = _instrumentation_scope{ instrumented::day_count_fraction };
+
+			return _day_count->fraction(p);
+		}
+
+		auto fraction(const serial_date from, const serial_date until) const -> double
+		{
+			return fraction(gregorian::days_period{ from_serial(from), from_serial(until) });
+		}
+
+		const coupon_schedule::day_count* _day_count;
+	};
+
+
+	// Business/252 (BRL CDI for example): the year fraction is the number of business days of the calendar over 252
+	// (the calendar has to cover all the periods and outlive the day count)
+	class business_252 final : public coupon_schedule::day_count
+	{
+
+	public:
+
+		explicit business_252(const bitset_calendar& publication) noexcept;
+
+	public:
+
+		auto get_calendar() const noexcept -> const bitset_calendar&;
+
+	private:
+
+		auto _fraction(const gregorian::days_period& p) const -> double final;
+
+	private:
+
+		const bitset_calendar* _publication;
+
+	};
+
+	// compile time version of the above
+	struct business_252_day_count final
+	{
+		auto fraction(const gregorian::days_period& p) const -> double
+		{
+			return fraction(to_serial(p.get_from()), to_serial(p.get_until()));
+		}
+
+		auto fraction(const serial_date from, const serial_date until) const -> double
+		{
+			const auto scope = _instrumentation_scope{ instrumented::day_count_fraction };
+
+			return _publication->count_business_days(from, until) / 252.0;
+		}
+
+		const bitset_calendar* _publication;
+	};
+
+
+	inline business_252::business_252(const bitset_calendar& publication) noexcept :
+		_publication{ &publication }
+	{
+	}
+
+	inline auto business_252::get_calendar() const noexcept -> const bitset_calendar&
+	{
+		return *_publication;
+	}
+
+	inline auto business_252::_fraction(const gregorian::days_period& p) const -> double
+	{
+		return business_252_day_count{ _publication }.fraction(p);
+	}
+
+
+	// calls f with the compile time version of the day count (if we have one)
+	template<typename F>
+	auto _visit_day_count(const coupon_schedule::day_count* const day_count, F&& f)
+	{
+		if (day_count == &coupon_schedule::Actual360)
+			return f(actual_360_day_count{});
+		else if (day_count == &coupon_schedule::Actual365Fixed)
+			return f(actual_365_fixed_day_count{});
+		else if (const auto b = dynamic_cast<const business_252*>(day_count))
+			return f(business_252_day_count{ &b->get_calendar() });
+		else
+			return f(_dynamic_day_count{ day_count });
+	}
+
+
+	// growth of 1.0 over a period (of the year fraction) at the rate and the other way around:
+	// simple interest for the money market day counts...
+	template<typename DayCount>
+	auto _growth(const DayCount&, const double rate, const double year_fraction) noexcept -> double
+	{
+		return 1.0 + rate * year_fraction;
+	}
+
+	template<typename DayCount>
+	auto _rate(const DayCount&, const double growth, const double year_fraction) noexcept -> double
+	{
+		return (growth - 1.0) / year_fraction;
+	}
+
+	// ...but rates quoted on Business/252 are annually compounded
+	// (the daily factor of CDI is (1 + rate) ^ (1 / 252), the compounded rate is annualised in the same way)
+	inline auto _growth(const business_252_day_count&, const double rate, const double year_fraction) noexcept -> double
+	{
+		return std::pow(1.0 + rate, year_fraction);
+	}
+
+	inline auto _rate(const business_252_day_count&, const double growth, const double year_fraction) noexcept -> double
+	{
+		return std::pow(growth, 1.0 / year_fraction) - 1.0;
+	}
+
+
+
+	// when is a compounded index rounded?
+	enum class rounding
+	{
+		output_only, // the running index is not rounded, only the published values are
+		every_step // the running index is rounded after each day (SARON)
+	};
+
+
+	// how a benchmark administrator calculates its compounded index
+	template<typename DayCount, rounding Rounding, unsigned DecimalPlaces>
+	struct compounded_index_convention final
+	{
+		using day_count = DayCount;
+
+		static constexpr auto rounding_policy = Rounding;
+		static constexpr auto decimal_places = DecimalPlaces;
+	};
+
+	// the day count is made up from its type when the index is calculated, so it can not carry any state
+	// (Business/252 needs its calendar, so it can not be used in a convention)
+	template<typename T>
+	concept index_convention = requires
+	{
+		typename T::day_count;
+		{ T::rounding_policy } -> std::convertible_to<rounding>;
+		{ T::decimal_places } -> std::convertible_to<unsigned>;
+	} &&
+		std::is_empty_v<typename T::day_count> &&
+		std::default_initializable<typename T::day_count>;
+
+	// the convention fixes the day count at compile time, so the one of the resets is only checked
+	// (otherwise the index would be calculated with one day count and labelled with another)
+	template<index_convention Convention>
+	auto _check_day_count(const Convention&, const coupon_schedule::day_count* const day_count) -> void
+	{
+		const auto same = _visit_day_count(
+			day_count,
+			[](const auto& dc) { return std::is_same_v<std::remove_cvref_t<decltype(dc)>, typename Convention::day_count>; }
+		);
+
+		if (!same)
+			throw std::invalid_argument{ "Day count of the resets is not the one of the convention" };
+	}
+
+
+	// SONIA Compounded Index
+	constexpr auto SONIACompoundedIndexConvention = compounded_index_convention<actual_365_fixed_day_count, rounding::output_only, 8u>{};
+
+	// Compounded Euro Short-Term Rate Index
+	constexpr auto EuroSTRCompoundedIndexConvention = compounded_index_convention<actual_360_day_count, rounding::output_only, 8u>{};
+
+	// SARON Index (and Swiss Current Index ON)
+	constexpr auto SARONCompoundedIndexConvention = compounded_index_convention<actual_360_day_count, rounding::every_step, 6u>{};
+
+	// SOFR Index
+	constexpr auto SOFRCompoundedIndexConvention = compounded_index_convention<actual_360_day_count, rounding::output_only, 8u>{};
+
+}
@@ -0,0 +1,205 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "dense_calendar.h"
+#include "instrumentation.h"
+
+#include <compounding_schedule.h>
+
+#include <period.h>
+
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+
+
+namespace risk_free_rate
+{
+
+	// the same overnight periods as coupon_schedule::make_compounding_schedule produces,
+	// but generated one by one from the calendar (so nothing is allocated)
+	template<publication_calendar Calendar>
+	class compounding_range final
+	{
+
+	public:
+
+		class iterator final
+		{
+
+		public:
+
+			using value_type = coupon_schedule::compounding_period;
+			using difference_type = std::ptrdiff_t;
+
+		public:
+
+			iterator() noexcept = default;
+
+			explicit iterator(
+				const std::chrono::year_month_day& from,
+				const std::chrono::year_month_day& until,
+				const Calendar* publication
+			);
+
+		public:
+
+			auto operator*() const -> value_type;
+
+			auto operator++() -> iterator&;
+			auto operator++(int) -> iterator;
+
+			friend auto operator==(const iterator& i, std::default_sentinel_t) noexcept -> bool
+			{
+				return i._from >= i._until;
+			}
+
+		private:
+
+			std::chrono::year_month_day _from;
+			std::chrono::year_month_day _maturity; // of the overnight period starting on _from
+			std::chrono::year_month_day _until;
+			const Calendar* _publication;
+
+		};
+
+	public:
+
+		explicit compounding_range(
+			std::chrono::year_month_day effective,
+			std::chrono::year_month_day maturity,
+			const Calendar& publication
+		) noexcept;
+
+	public:
+
+		auto begin() const -> iterator;
+		auto end() const noexcept -> std::default_sentinel_t;
+
+		auto get_effective() const noexcept -> const std::chrono::year_month_day&;
+		auto get_maturity() const noexcept -> const std::chrono::year_month_day&;
+
+	private:
+
+		std::chrono::year_month_day _effective;
+		std::chrono::year_month_day _maturity;
+		const Calendar* _publication;
+
+	};
+
+
+	template<publication_calendar Calendar>
+	compounding_range<Calendar>::iterator::iterator(
+		const std::chrono::year_month_day& from,
+		const std::chrono::year_month_day& until,
+		const Calendar* publication
+	) :
+		_from{ from },
+		_maturity{},
+		_until{ until },
+		_publication{ publication }
+	{
+		if (_from < _until)
+			_maturity = _make_overnight_maturity(_from, *_publication);
+	}
+
+	template<publication_calendar Calendar>
+	auto compounding_range<Calendar>::iterator::operator*() const -> value_type
+	{
+		return { _from, { _from, _maturity } };
+	}
+
+	template<publication_calendar Calendar>
+	auto compounding_range<Calendar>::iterator::operator++() -> iterator&
+	{
+		_from = _maturity;
+		if (_from < _until)
+			_maturity = _make_overnight_maturity(_from, *_publication);
+
+		return *this;
+	}
+
+	template<publication_calendar Calendar>
+	auto compounding_range<Calendar>::iterator::operator++(int) -> iterator
+	{
+		auto result = *this;
+		++*this;
+
+		return result;
+	}
+
+
+	template<publication_calendar Calendar>
+	compounding_range<Calendar>::compounding_range(
+		std::chrono::year_month_day effective,
+		std::chrono::year_month_day maturity,
+		const Calendar& publication
+	) noexcept :
+		_effective{ std::move(effective) },
+		_maturity{ std::move(maturity) },
+		_publication{ &publication }
+	{
+	}
+
+	template<publication_calendar Calendar>
+	auto compounding_range<Calendar>::begin() const -> iterator
+	{
+		return iterator{ _effective, _maturity, _publication };
+	}
+
+	template<publication_calendar Calendar>
+	auto compounding_range<Calendar>::end() const noexcept -> std::default_sentinel_t
+	{
+		return std::default_sentinel;
+	}
+
+	template<publication_calendar Calendar>
+	auto compounding_range<Calendar>::get_effective() const noexcept -> const std::chrono::year_month_day&
+	{
+		return _effective;
+	}
+
+	template<publication_calendar Calendar>
+	auto compounding_range<Calendar>::get_maturity() const noexcept -> const std::chrono::year_month_day&
+	{
+		return _maturity;
+	}
+
+
+	// materialises the schedule into a buffer owned by the caller
+	// (once the buffer has grown to the longest schedule nothing is allocated)
+	template<publication_calendar Calendar>
+	auto fill_compounding_schedule(
+		const compounding_range<Calendar>& range,
+		coupon_schedule::compounding_periods& scratch
+	) -> void
+	{
+		const auto scope = _instrumentation_scope{ instrumented::compounding_schedule };
+
+		scratch.clear();
+		for (const auto& p : range)
+			scratch.push_back(p);
+	}
+
+}
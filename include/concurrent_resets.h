@@ -0,0 +1,352 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <round.h>
+#include <resets.h>
+
+#include <day_count_interface.h>
+
+#include <period.h>
+#include <time_series.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+namespace risk_free_rate
+{
+
+	// immutable version of resets: the history, which is shared by many versions,
+	// and a few observations published on top of it
+	class resets_version final
+	{
+
+	public:
+
+		using observation = std::pair<std::chrono::year_month_day, double>; // as stored (i.e. as a percentage for rates)
+
+	public:
+
+		explicit resets_version(
+			std::shared_ptr<const resets> history,
+			std::vector<observation> recent,
+			const std::uint64_t version
+		) noexcept;
+
+	public:
+
+		// the same as resets::operator[] (throws if the reset is missing)
+		auto operator[](const std::chrono::year_month_day& ymd) const -> double;
+
+		auto last_reset_year_month_day() const -> std::chrono::year_month_day;
+
+		auto get_day_count() const noexcept -> const coupon_schedule::day_count*;
+		auto get_version() const noexcept -> std::uint64_t;
+
+		auto get_history() const noexcept -> const std::shared_ptr<const resets>&;
+		auto get_recent() const noexcept -> const std::vector<observation>&;
+
+		// a single resets (for the builders), which covers the recent observations as well
+		auto to_resets() const -> resets;
+
+	private:
+
+		std::shared_ptr<const resets> _history;
+		std::vector<observation> _recent; // sorted by date, never longer than a few dozen observations
+		std::uint64_t _version;
+
+	};
+
+
+	inline resets_version::resets_version(
+		std::shared_ptr<const resets> history,
+		std::vector<observation> recent,
+		const std::uint64_t version
+	) noexcept :
+		_history{ std::move(history) },
+		_recent{ std::move(recent) },
+		_version{ version }
+	{
+	}
+
+
+	inline auto resets_version::operator[](const std::chrono::year_month_day& ymd) const -> double
+	{
+		const auto r = std::lower_bound(
+			_recent.cbegin(),
+			_recent.cend(),
+			ymd,
+			[](const observation& o, const std::chrono::year_month_day& d) { return o.first < d; }
+		);
+		if (r != _recent.cend() && r->first == ymd)
+			return from_percent(r->second);
+
+		return (*_history)[ymd];
+	}
+
+	inline auto resets_version::last_reset_year_month_day() const -> std::chrono::year_month_day
+	{
+		const auto last = _history->last_reset_year_month_day();
+
+		return _recent.empty() ? last : std::max(last, _recent.back().first);
+	}
+
+	inline auto resets_version::get_day_count() const noexcept -> const coupon_schedule::day_count*
+	{
+		return _history->get_day_count();
+	}
+
+	inline auto resets_version::get_version() const noexcept -> std::uint64_t
+	{
+		return _version;
+	}
+
+	inline auto resets_version::get_history() const noexcept -> const std::shared_ptr<const resets>&
+	{
+		return _history;
+	}
+
+	inline auto resets_version::get_recent() const noexcept -> const std::vector<observation>&
+	{
+		return _recent;
+	}
+
+
+	inline auto resets_version::to_resets() const -> resets
+	{
+		const auto& ts = _history->get_time_series();
+		const auto& period = ts.get_period();
+
+		auto until = period.get_until();
+		if (!_recent.empty())
+			until = std::max(until, _recent.back().first);
+
+		auto result = resets::storage{ gregorian::days_period{ period.get_from(), until } };
+
+		for (auto d = std::chrono::sys_days{ period.get_from() }; d <= std::chrono::sys_days{ period.get_until() }; d += std::chrono::days{ 1 })
+			result[d] = ts[d];
+
+		for (const auto& [d, o] : _recent)
+			result[d] = o;
+
+		return resets{ std::move(result), _history->get_day_count() };
+	}
+
+
+
+	// resets which are read by many threads while new observations are published
+	// (readers take a snapshot, which stays valid and unchanged for as long as they hold it)
+	// the current version is an atomic raw pointer, which the writer replaces and then reclaims the old one
+	// once no reader can still be looking at it (epoch based reclamation) - a reader only announces itself
+	// for as long as it takes to copy the shared_ptr of the version, so it never waits for a writer or other readers:
+	// it tries each of _reader_slots slots once, and if they are all taken (more readers than slots are taking
+	// a snapshot at the same moment) it announces itself in a shared counter instead, which holds back
+	// the reclamation of all the old versions until no such reader is left
+	class concurrent_resets final
+	{
+
+	public:
+
+		explicit concurrent_resets(resets r);
+
+		concurrent_resets(const concurrent_resets&) = delete;
+		auto operator=(const concurrent_resets&) -> concurrent_resets& = delete;
+
+	public:
+
+		auto snapshot() const noexcept -> std::shared_ptr<const resets_version>;
+
+		// publishes a new version with the observation added (or replaced)
+		// (writers are serialised between themselves, but not with readers)
+		auto publish(const std::chrono::year_month_day& ymd, const double observation) -> void;
+
+	private:
+
+		static constexpr auto _reader_slots = std::size_t{ 64u };
+
+		// the epoch a reader saw when it started (0 if the slot is free)
+		struct alignas(64) _reader_slot
+		{
+			std::atomic<std::uint64_t> _epoch{ 0u };
+		};
+
+		struct _retired_version
+		{
+			std::unique_ptr<const std::shared_ptr<const resets_version>> _version;
+			std::uint64_t _epoch; // readers from this epoch or earlier might still see it
+		};
+
+	private:
+
+		// nothing if all the slots are taken
+		auto _pin() const noexcept -> std::atomic<std::uint64_t>*;
+
+		auto _reclaim() -> void;
+
+	private:
+
+		// owned by the writer (the readers only copy the shared_ptr it points to)
+		std::unique_ptr<const std::shared_ptr<const resets_version>> _head;
+
+		std::atomic<const std::shared_ptr<const resets_version>*> _current;
+
+		mutable std::atomic<std::uint64_t> _epoch;
+		mutable std::array<_reader_slot, _reader_slots> _readers;
+		mutable std::atomic<std::size_t> _overflow_readers; // readers without a slot
+
+		std::vector<_retired_version> _retired;
+
+		std::mutex _writer;
+
+	};
+
+
+	// once there are this many recent observations they are folded into a new history
+	// (so publishing is cheap most of the time and look ups stay fast)
+	constexpr auto _max_recent_observations = std::size_t{ 32u };
+
+
+	inline concurrent_resets::concurrent_resets(resets r) :
+		_head{ std::make_unique<const std::shared_ptr<const resets_version>>(
+			std::make_shared<const resets_version>(std::make_shared<const resets>(std::move(r)), std::vector<resets_version::observation>{}, 0u)
+		) },
+		_current{ _head.get() },
+		_epoch{ 1u },
+		_readers{},
+		_overflow_readers{ 0u },
+		_retired{},
+		_writer{}
+	{
+	}
+
+	inline auto concurrent_resets::snapshot() const noexcept -> std::shared_ptr<const resets_version>
+	{
+		const auto slot = _pin();
+		if (!slot)
+			_overflow_readers.fetch_add(1u);
+
+		// the writer does not reclaim anything we can see here until the slot (or the counter) is released
+		auto result = *_current.load();
+
+		if (slot)
+			slot->store(0u);
+		else
+			_overflow_readers.fetch_sub(1u);
+
+		return result;
+	}
+
+	inline auto concurrent_resets::publish(const std::chrono::year_month_day& ymd, const double observation) -> void
+	{
+		const auto lock = std::lock_guard{ _writer };
+
+		const auto& current = *_head;
+
+		if (ymd < current->get_history()->get_time_series().get_period().get_from())
+			throw std::out_of_range{ "Observation is before the history" };
+
+		auto recent = current->get_recent();
+		const auto r = std::lower_bound(
+			recent.begin(),
+			recent.end(),
+			ymd,
+			[](const resets_version::observation& o, const std::chrono::year_month_day& d) { return o.first < d; }
+		);
+		if (r != recent.end() && r->first == ymd)
+			r->second = observation;
+		else
+			recent.insert(r, { ymd, observation });
+
+		auto next = std::shared_ptr<const resets_version>{};
+		if (recent.size() < _max_recent_observations)
+		{
+			next = std::make_shared<const resets_version>(current->get_history(), std::move(recent), current->get_version() + 1u);
+		}
+		else
+		{
+			const auto merged = resets_version{ current->get_history(), std::move(recent), 0u };
+			next = std::make_shared<const resets_version>(
+				std::make_shared<const resets>(merged.to_resets()),
+				std::vector<resets_version::observation>{},
+				current->get_version() + 1u
+			);
+		}
+
+		auto head = std::make_unique<const std::shared_ptr<const resets_version>>(std::move(next));
+		_current.store(head.get());
+
+		// readers which announced themselves after this saw the new version
+		const auto epoch = _epoch.fetch_add(1u);
+		_retired.push_back({ std::exchange(_head, std::move(head)), epoch });
+
+		_reclaim();
+	}
+
+
+	inline auto concurrent_resets::_pin() const noexcept -> std::atomic<std::uint64_t>*
+	{
+		// start from a different slot in each thread, so that normally the first one is free
+		const auto start = std::hash<std::thread::id>{}(std::this_thread::get_id());
+
+		for (auto i = std::size_t{ 0u }; i < _reader_slots; ++i)
+		{
+			auto& slot = _readers[(start + i) % _reader_slots]._epoch;
+
+			auto expected = std::uint64_t{ 0u };
+			if (slot.load() == 0u && slot.compare_exchange_strong(expected, _epoch.load()))
+				return &slot;
+		}
+
+		return nullptr;
+	}
+
+	inline auto concurrent_resets::_reclaim() -> void
+	{
+		// a reader without a slot might be looking at any version we retired (it is reclaimed next time)
+		if (_overflow_readers.load() != 0u)
+			return;
+
+		auto oldest = _epoch.load(); // the oldest epoch a reader might still be in
+		for (const auto& r : _readers)
+		{
+			const auto e = r._epoch.load();
+			if (e != 0u)
+				oldest = std::min(oldest, e);
+		}
+
+		std::erase_if(_retired, [oldest](const _retired_version& r) { return r._epoch < oldest; });
+	}
+
+}
@@ -0,0 +1,176 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "accrual_factors.h"
+#include "compounding_conventions.h"
+
+#include <coupon_period.h>
+
+#include <algorithm>
+#include <execution>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+
+namespace risk_free_rate
+{
+
+	// coupon periods of a book which reference the same benchmark
+	struct coupon_batch
+	{
+		const accrual_factors* _factors;
+		std::span<const coupon_schedule::coupon_period> _coupons;
+	};
+
+
+	// a distinct (benchmark, effective, maturity) combination
+	struct _coupon_window
+	{
+		const accrual_factors* _factors;
+		std::size_t _from; // slots in the factors
+		std::size_t _until;
+
+		friend auto operator==(const _coupon_window&, const _coupon_window&) -> bool = default;
+	};
+
+	// (std::less gives a total order of pointers, unlike the built in comparison)
+	inline auto _window_less(const _coupon_window& w1, const _coupon_window& w2) noexcept -> bool
+	{
+		if (w1._factors != w2._factors)
+			return std::less<const accrual_factors*>{}(w1._factors, w2._factors);
+
+		return std::tie(w1._from, w1._until) < std::tie(w2._from, w2._until);
+	}
+
+
+	// multiplies exactly the same factors in exactly the same order as compound() does,
+	// so the result is bit for bit the same as compound() over the schedule of the coupon period
+	inline auto _compound_window(const _coupon_window& w) -> double
+	{
+		const auto& f = w._factors->get_factors();
+		const auto& dates = w._factors->get_dates();
+
+		auto c = 1.0;
+		for (auto i = w._from; i < w._until; ++i)
+			c *= f[i];
+
+		return _visit_day_count(
+			w._factors->get_day_count(),
+			[&](const auto& dc) { return _rate(dc, c, dc.fraction({ dates[w._from], dates[w._until] })); }
+		);
+	}
+
+
+	// compounded (in arrears, not rounded) rates for all the coupons of all the batches:
+	// identical windows are calculated only once, in the order of their start (so the factors are read mostly sequentially)
+	// and according to the execution policy (in parallel for example)
+	// (accrual periods are expected to start and end on business days within the period of the factors
+	// and to be at least a day long - an empty one throws, as there is no rate to compound over it)
+	template<typename ExecutionPolicy>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	auto compound_coupons(
+		ExecutionPolicy&& policy,
+		std::span<const coupon_batch> batches
+	) -> std::vector<std::vector<double>>
+	{
+		auto windows = std::vector<_coupon_window>{};
+		for (const auto& b : batches)
+			for (const auto& c : b._coupons)
+			{
+				// checked here, as an exception can not leave a parallel algorithm below
+				const auto& p = c.get_accrual_period();
+				if (p.get_from() == p.get_until())
+					throw std::invalid_argument{ "Accrual period is empty" };
+
+				windows.push_back({ b._factors, b._factors->slot(p.get_from()), b._factors->slot(p.get_until()) });
+			}
+
+		// the same order (factors first) is used for the look up below
+		auto unique = windows;
+		std::sort(unique.begin(), unique.end(), _window_less);
+		unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+		auto rates = std::vector<double>(unique.size());
+		std::transform(
+			std::forward<ExecutionPolicy>(policy),
+			unique.cbegin(),
+			unique.cend(),
+			rates.begin(),
+			_compound_window
+		);
+
+		auto result = std::vector<std::vector<double>>{};
+		result.reserve(batches.size());
+
+		auto w = windows.cbegin();
+		for (const auto& b : batches)
+		{
+			auto& r = result.emplace_back();
+			r.reserve(b._coupons.size());
+
+			for (auto i = std::size_t{ 0u }; i < b._coupons.size(); ++i, ++w)
+			{
+				const auto u = std::lower_bound(unique.cbegin(), unique.cend(), *w, _window_less);
+				r.push_back(rates[u - unique.cbegin()]);
+			}
+		}
+
+		return result;
+	}
+
+	inline auto compound_coupons(std::span<const coupon_batch> batches) -> std::vector<std::vector<double>>
+	{
+		return compound_coupons(std::execution::seq, batches);
+	}
+
+	// a single benchmark
+	template<typename ExecutionPolicy>
+		requires std::is_execution_policy_v<std::remove_cvref_t<ExecutionPolicy>>
+	auto compound_coupons(
+		ExecutionPolicy&& policy,
+		const accrual_factors& factors,
+		std::span<const coupon_schedule::coupon_period> coupons
+	) -> std::vector<double>
+	{
+		const auto batch = coupon_batch{ &factors, coupons };
+
+		auto result = compound_coupons(std::forward<ExecutionPolicy>(policy), std::span{ &batch, 1u });
+
+		return std::move(result.front());
+	}
+
+	inline auto compound_coupons(
+		const accrual_factors& factors,
+		std::span<const coupon_schedule::coupon_period> coupons
+	) -> std::vector<double>
+	{
+		return compound_coupons(std::execution::seq, factors, coupons);
+	}
+
+}
@@ -0,0 +1,304 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "instrumentation.h"
+#include "serial_date.h"
+
+#include <compounding_schedule.h>
+
+#include <period.h>
+#include <calendar.h>
+
+#include <chrono>
+#include <vector>
+#include <concepts>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+
+namespace risk_free_rate
+{
+
+	// business days of a calendar precomputed for a period, so that questions like
+	// "what is the next business day?" are answered by a single lookup
+	// (the calendar itself is still needed for business day conventions, so we keep a reference to it)
+	class dense_calendar final
+	{
+
+	public:
+
+		explicit dense_calendar(
+			const gregorian::calendar& cal,
+			gregorian::days_period from_until
+		);
+
+		// we keep a pointer to the calendar, so it has to outlive us
+		dense_calendar(gregorian::calendar&&, gregorian::days_period) = delete;
+
+	public:
+
+		auto is_business_day(const std::chrono::year_month_day& ymd) const -> bool;
+
+		// the first business day after ymd (the same as coupon_schedule::make_overnight_maturity)
+		auto next_business_day(const std::chrono::year_month_day& ymd) const -> std::chrono::year_month_day;
+
+		// the last business day before ymd
+		auto previous_business_day(const std::chrono::year_month_day& ymd) const -> std::chrono::year_month_day;
+
+		// number of business days in the period before ymd
+		auto business_day_ordinal(const std::chrono::year_month_day& ymd) const -> std::size_t;
+
+		// the same as above, but without converting from (or to) year_month_day
+		auto is_business_day(const serial_date d) const -> bool;
+		auto next_business_day(const serial_date d) const -> serial_date;
+		auto previous_business_day(const serial_date d) const -> serial_date;
+		auto business_day_ordinal(const serial_date d) const -> std::size_t;
+
+	public:
+
+		auto get_calendar() const noexcept -> const gregorian::calendar&;
+		auto get_period() const noexcept -> const gregorian::days_period&;
+
+	private:
+
+		auto _index(const serial_date d) const -> std::size_t;
+
+	private:
+
+		const gregorian::calendar* _calendar;
+
+		gregorian::days_period _period;
+
+		serial_date _from;
+		serial_date _until;
+
+		// for each calendar day in the period
+		std::vector<std::uint8_t> _business_days;
+		std::vector<serial_date> _next;
+		std::vector<serial_date> _previous;
+		std::vector<std::uint32_t> _ordinals;
+
+	};
+
+
+	inline dense_calendar::dense_calendar(
+		const gregorian::calendar& cal,
+		gregorian::days_period from_until
+	) :
+		_calendar{ &cal },
+		_period{ std::move(from_until) },
+		_from{ to_serial(_period.get_from()) },
+		_until{ to_serial(_period.get_until()) },
+		_business_days{},
+		_next{},
+		_previous{},
+		_ordinals{}
+	{
+		const auto from = std::chrono::sys_days{ _period.get_from() };
+		const auto until = std::chrono::sys_days{ _period.get_until() };
+
+		const auto size = static_cast<std::size_t>((until - from).count() + 1);
+
+		_business_days.resize(size);
+		_next.resize(size);
+		_previous.resize(size);
+		_ordinals.resize(size);
+
+		auto ordinal = std::uint32_t{ 0u };
+		for (auto i = std::size_t{ 0u }; i < size; ++i)
+		{
+			_business_days[i] = cal.is_business_day(from + std::chrono::days{ i });
+			_ordinals[i] = ordinal;
+
+			if (_business_days[i])
+				++ordinal;
+		}
+
+		// the first and the last days might need business days from outside of the period
+		auto next = until + std::chrono::days{ 1 };
+		while (!cal.is_business_day(next))
+			next += std::chrono::days{ 1 };
+
+		for (auto i = size; i-- > 0u;)
+		{
+			_next[i] = to_serial(next);
+
+			if (_business_days[i])
+				next = from + std::chrono::days{ i };
+		}
+
+		auto previous = from - std::chrono::days{ 1 };
+		while (!cal.is_business_day(previous))
+			previous -= std::chrono::days{ 1 };
+
+		for (auto i = std::size_t{ 0u }; i < size; ++i)
+		{
+			_previous[i] = to_serial(previous);
+
+			if (_business_days[i])
+				previous = from + std::chrono::days{ i };
+		}
+	}
+
+
+	inline auto dense_calendar::is_business_day(const std::chrono::year_month_day& ymd) const -> bool
+	{
+		return is_business_day(to_serial(ymd));
+	}
+
+	inline auto dense_calendar::next_business_day(const std::chrono::year_month_day& ymd) const -> std::chrono::year_month_day
+	{
+		return from_serial(next_business_day(to_serial(ymd)));
+	}
+
+	inline auto dense_calendar::previous_business_day(const std::chrono::year_month_day& ymd) const -> std::chrono::year_month_day
+	{
+		return from_serial(previous_business_day(to_serial(ymd)));
+	}
+
+	inline auto dense_calendar::business_day_ordinal(const std::chrono::year_month_day& ymd) const -> std::size_t
+	{
+		return business_day_ordinal(to_serial(ymd));
+	}
+
+
+	inline auto dense_calendar::is_business_day(const serial_date d) const -> bool
+	{
+		return _business_days[_index(d)];
+	}
+
+	inline auto dense_calendar::next_business_day(const serial_date d) const -> serial_date
+	{
+		return _next[_index(d)];
+	}
+
+	inline auto dense_calendar::previous_business_day(const serial_date d) const -> serial_date
+	{
+		return _previous[_index(d)];
+	}
+
+	inline auto dense_calendar::business_day_ordinal(const serial_date d) const -> std::size_t
+	{
+		return _ordinals[_index(d)];
+	}
+
+
+	inline auto dense_calendar::get_calendar() const noexcept -> const gregorian::calendar&
+	{
+		return *_calendar;
+	}
+
+	inline auto dense_calendar::get_period() const noexcept -> const gregorian::days_period&
+	{
+		return _period;
+	}
+
+
+	inline auto dense_calendar::_index(const serial_date d) const -> std::size_t
+	{
+		if (d < _from || d > _until)
+			throw std::out_of_range{ "Date is outside of the dense calendar" };
+
+		return static_cast<std::size_t>(d - _from);
+	}
+
+
+
+	// builders in this library work with either of the calendars through the functions below
+
+	inline auto _make_overnight_maturity(
+		const std::chrono::year_month_day& ymd,
+		const gregorian::calendar& publication
+	) -> std::chrono::year_month_day
+	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
+		return coupon_schedule::make_overnight_maturity(ymd, publication);
+	}
+
+	inline auto _make_overnight_maturity(
+		const std::chrono::year_month_day& ymd,
+		const dense_calendar& publication
+	) -> std::chrono::year_month_day
+	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
+		return publication.next_business_day(ymd);
+	}
+
+	// a business day in both representations, so that walking through the business days converts only once a day
+	// (the calendar walks in year_month_day and the dense calendar in serial dates)
+	struct _business_day
+	{
+		serial_date _serial;
+		std::chrono::year_month_day _ymd;
+	};
+
+	inline auto _make_business_day(const std::chrono::year_month_day& ymd) noexcept -> _business_day
+	{
+		return { to_serial(ymd), ymd };
+	}
+
+	inline auto _make_overnight_maturity(
+		const _business_day& d,
+		const gregorian::calendar& publication
+	) -> _business_day
+	{
+		return _make_business_day(_make_overnight_maturity(d._ymd, publication));
+	}
+
+	inline auto _make_overnight_maturity(
+		const _business_day& d,
+		const dense_calendar& publication
+	) -> _business_day
+	{
+		const auto scope = _instrumentation_scope{ instrumented::calendar_lookup };
+
+		const auto maturity = publication.next_business_day(d._serial);
+
+		return { maturity, from_serial(maturity) };
+	}
+
+
+	inline auto _get_calendar(const gregorian::calendar& publication) noexcept -> const gregorian::calendar&
+	{
+		return publication;
+	}
+
+	inline auto _get_calendar(const dense_calendar& publication) noexcept -> const gregorian::calendar&
+	{
+		return publication.get_calendar();
+	}
+
+
+	template<typename T>
+	concept publication_calendar = requires(const T& publication, const std::chrono::year_month_day& ymd, const _business_day& d)
+	{
+		{ _make_overnight_maturity(ymd, publication) } -> std::same_as<std::chrono::year_month_day>;
+		{ _make_overnight_maturity(d, publication) } -> std::same_as<_business_day>;
+		{ _get_calendar(publication) } -> std::same_as<const gregorian::calendar&>;
+	};
+
+}
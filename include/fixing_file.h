@@ -0,0 +1,325 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "mapped_file.h"
+
+#include <resets.h>
+
+#include <period.h>
+#include <time_series.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <utility>
+#include <charconv>
+#include <stdexcept>
+#include <cstddef>
+
+
+namespace risk_free_rate
+{
+
+	// date formats of the files published by the administrators of the benchmarks
+	enum class date_format
+	{
+		dd_mmm_yy, // 01 Jun 23 (SONIA)
+		yyyy_mm_dd, // 2023-06-01 (EuroSTR)
+		dd_mm_yyyy // 01.06.2023 (SARON)
+	};
+
+
+	inline auto _parse_unsigned(const std::string_view s) noexcept -> std::optional<unsigned>
+	{
+		if (s.empty())
+			return std::nullopt;
+
+		auto result = 0u;
+		for (const auto c : s)
+		{
+			if (c < '0' || c > '9')
+				return std::nullopt;
+
+			result = result * 10u + static_cast<unsigned>(c - '0');
+		}
+
+		return result;
+	}
+
+	inline auto _parse_month_abbreviation(const std::string_view s) noexcept -> std::optional<unsigned>
+	{
+		constexpr auto abbreviations = std::string_view{ "JanFebMarAprMayJunJulAugSepOctNovDec" };
+
+		for (auto m = 0u; m < 12u; ++m)
+			if (abbreviations.substr(m * 3u, 3u) == s)
+				return m + 1u;
+
+		return std::nullopt;
+	}
+
+	inline auto _parse_date(const std::string_view s, const date_format format) noexcept -> std::optional<std::chrono::year_month_day>
+	{
+		auto y = std::optional<unsigned>{};
+		auto m = std::optional<unsigned>{};
+		auto d = std::optional<unsigned>{};
+
+		switch (format)
+		{
+		case date_format::dd_mmm_yy:
+			if (s.size() == 9u && s[2] == ' ' && s[6] == ' ')
+			{
+				d = _parse_unsigned(s.substr(0u, 2u));
+				m = _parse_month_abbreviation(s.substr(3u, 3u));
+				y = _parse_unsigned(s.substr(7u, 2u));
+				if (y)
+					*y += *y >= 69u ? 1900u : 2000u; // the same pivot as %y of std::chrono::parse
+			}
+			break;
+		case date_format::yyyy_mm_dd:
+			if (s.size() == 10u && s[4] == '-' && s[7] == '-')
+			{
+				y = _parse_unsigned(s.substr(0u, 4u));
+				m = _parse_unsigned(s.substr(5u, 2u));
+				d = _parse_unsigned(s.substr(8u, 2u));
+			}
+			break;
+		case date_format::dd_mm_yyyy:
+			if (s.size() == 10u && s[2] == '.' && s[5] == '.')
+			{
+				d = _parse_unsigned(s.substr(0u, 2u));
+				m = _parse_unsigned(s.substr(3u, 2u));
+				y = _parse_unsigned(s.substr(6u, 4u));
+			}
+			break;
+		}
+
+		if (!y || !m || !d)
+			return std::nullopt;
+
+		const auto result = std::chrono::year_month_day{
+			std::chrono::year{ static_cast<int>(*y) },
+			std::chrono::month{ *m },
+			std::chrono::day{ *d }
+		};
+		if (!result.ok())
+			return std::nullopt;
+
+		return result;
+	}
+
+	inline auto detect_date_format(const std::string_view s) -> date_format
+	{
+		for (const auto format : { date_format::dd_mmm_yy, date_format::yyyy_mm_dd, date_format::dd_mm_yyyy })
+			if (_parse_date(s, format))
+				return format;
+
+		throw std::invalid_argument{ "Unknown date format: " + std::string{ s } };
+	}
+
+	// empty observations are not an error (they are just missing)
+	inline auto _parse_decimal(std::string_view s) -> std::optional<double>
+	{
+		while (!s.empty() && s.front() == ' ')
+			s.remove_prefix(1u);
+		while (!s.empty() && s.back() == ' ')
+			s.remove_suffix(1u);
+
+		if (s.empty())
+			return std::nullopt;
+
+		// from_chars is correctly rounded, so we get exactly the same doubles as from stod
+		auto result = 0.0;
+		const auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), result);
+		if (ec != std::errc{} || ptr != s.data() + s.size())
+			throw std::invalid_argument{ "Cannot parse observation: " + std::string{ s } };
+
+		return result;
+	}
+
+
+	// removes the first line from text (without the end of line characters)
+	inline auto _next_line(std::string_view& text) noexcept -> std::string_view
+	{
+		const auto n = text.find('\n');
+		auto line = text.substr(0u, n);
+		text.remove_prefix(n == std::string_view::npos ? text.size() : n + 1u);
+
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1u);
+
+		return line;
+	}
+
+	// removes the first field from line (quotes around the field are removed as well)
+	inline auto _next_field(std::string_view& line, const char separator) noexcept -> std::string_view
+	{
+		auto field = std::string_view{};
+
+		if (!line.empty() && line.front() == '"')
+		{
+			const auto q = line.find('"', 1u); // we do not expect escaped quotes
+			field = line.substr(1u, q == std::string_view::npos ? std::string_view::npos : q - 1u);
+			line.remove_prefix(q == std::string_view::npos ? line.size() : q + 1u);
+		}
+		else
+		{
+			const auto n = line.find(separator);
+			field = line.substr(0u, n);
+			line.remove_prefix(n == std::string_view::npos ? line.size() : n);
+		}
+
+		if (!line.empty()) // separator
+			line.remove_prefix(1u);
+
+		return field;
+	}
+
+	inline auto _field(std::string_view line, const std::size_t index, const char separator) noexcept -> std::string_view
+	{
+		for (auto i = std::size_t{ 0u }; i < index; ++i)
+			_next_field(line, separator);
+
+		return _next_field(line, separator);
+	}
+
+	inline auto _find_column(std::string_view header, const std::string_view name, const char separator) -> std::size_t
+	{
+		for (auto i = std::size_t{ 0u }; !header.empty(); ++i)
+			if (_next_field(header, separator) == name)
+				return i;
+
+		throw std::invalid_argument{ "Column not found: " + std::string{ name } };
+	}
+
+
+	// loads several columns of observations straight from the file as published in a single pass
+	// (we expect a single row of titles and observations stored in decreasing order in time)
+	// each observation column can be requested only once and cannot be the date column
+	inline auto load_fixings(
+		const std::string& file_name,
+		const std::string_view date_column,
+		const std::vector<std::string_view>& observation_columns,
+		const char separator = ','
+	) -> std::vector<resets::storage>
+	{
+		const auto file = mapped_file{ file_name };
+
+		auto text = file.view();
+
+		const auto header = _next_line(text);
+		const auto date_index = _find_column(header, date_column, separator);
+
+		// for each field of a row: where it goes (none, the date or one of the observations)
+		constexpr auto skip = -2;
+		constexpr auto date = -1;
+		auto targets = std::vector<int>(date_index + 1u, skip);
+		targets[date_index] = date;
+		for (auto c = std::size_t{ 0u }; c < observation_columns.size(); ++c)
+		{
+			const auto i = _find_column(header, observation_columns[c], separator);
+			if (i >= targets.size())
+				targets.resize(i + 1u, skip);
+
+			if (targets[i] == date)
+				throw std::invalid_argument{ "Date column requested as observations: " + std::string{ observation_columns[c] } };
+			if (targets[i] != skip)
+				throw std::invalid_argument{ "Column requested more than once: " + std::string{ observation_columns[c] } };
+
+			targets[i] = static_cast<int>(c);
+		}
+
+		while (!text.empty() && (text.back() == '\n' || text.back() == '\r'))
+			text.remove_suffix(1u);
+
+		if (text.empty())
+			return std::vector<resets::storage>(observation_columns.size(), resets::storage{ { {}, {} } });
+
+		// the first and the last rows give us the period, so the storage can be filled in a single pass
+		auto first = text;
+		const auto first_line = _next_line(first); // without '\r' of a CRLF file
+		const auto last_line = text.substr(text.rfind('\n') + 1u); // npos + 1 is 0
+
+		const auto first_date = _field(first_line, date_index, separator);
+		const auto last_date = _field(last_line, date_index, separator);
+		const auto format = detect_date_format(first_date);
+
+		const auto until = _parse_date(first_date, format);
+		const auto from = _parse_date(last_date, format);
+		if (!until || !from)
+			throw std::invalid_argument{ "Cannot parse the period of " + file_name };
+
+		auto result = std::vector<resets::storage>(
+			observation_columns.size(),
+			resets::storage{ gregorian::days_period{ *from, *until } }
+		);
+
+		auto fields = std::vector<std::string_view>(observation_columns.size());
+		while (!text.empty())
+		{
+			auto line = _next_line(text);
+			if (line.empty())
+				continue;
+
+			// each row is tokenized once, whatever the number of columns
+			auto date_field = std::string_view{};
+			for (const auto t : targets)
+			{
+				const auto field = _next_field(line, separator);
+				if (t == date)
+					date_field = field;
+				else if (t != skip)
+					fields[t] = field;
+			}
+
+			const auto d = _parse_date(date_field, format);
+			if (!d)
+				throw std::invalid_argument{ "Cannot parse date: " + std::string{ date_field } };
+
+			for (auto c = std::size_t{ 0u }; c < fields.size(); ++c)
+			{
+				const auto observation = _parse_decimal(fields[c]);
+				if (observation)
+					result[c][*d] = observation;
+			}
+		}
+
+		return result;
+	}
+
+	// loads a single column of observations
+	inline auto load_fixings(
+		const std::string& file_name,
+		const std::string_view date_column,
+		const std::string_view observation_column,
+		const char separator = ','
+	) -> resets::storage
+	{
+		auto result = load_fixings(file_name, date_column, std::vector<std::string_view>{ observation_column }, separator);
+
+		return std::move(result.front());
+	}
+
+}
@@ -0,0 +1,256 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <period.h>
+#include <schedule.h>
+
+#include <chrono>
+#include <array>
+#include <algorithm>
+#include <cstddef>
+
+
+namespace risk_free_rate
+{
+
+	// holidays of the publication calendars of the benchmarks we support, worked out by the compiler
+	// (the rules are the ones in test/setup.h, where the tables are checked against them -
+	// so a calendar is ready at startup without evaluating Easter, weekday or offset rules year by year)
+	// when a calendar is extended both the rules and the table need updating
+
+
+	constexpr auto _holiday_table_capacity = std::size_t{ 512u };
+
+	// holidays in the order they are added, sorted and deduplicated by finish
+	// (the size is only known once all the rules have been applied, see _shrink)
+	struct _holiday_table_builder
+	{
+		std::array<std::chrono::year_month_day, _holiday_table_capacity> _dates{};
+		std::size_t _size{ 0u };
+
+		constexpr auto add(const std::chrono::year_month_day& ymd) -> void
+		{
+			_dates[_size++] = ymd; // going over the capacity does not compile
+		}
+
+		constexpr auto add(const std::chrono::sys_days& d) -> void
+		{
+			add(std::chrono::year_month_day{ d });
+		}
+
+		constexpr auto finish() -> void
+		{
+			const auto first = _dates.begin();
+			const auto last = first + _size;
+			std::sort(first, last);
+			_size = static_cast<std::size_t>(std::unique(first, last) - first);
+		}
+	};
+
+	template<std::size_t N>
+	constexpr auto _shrink(const _holiday_table_builder& builder) -> std::array<std::chrono::year_month_day, N>
+	{
+		auto result = std::array<std::chrono::year_month_day, N>{};
+		std::copy_n(builder._dates.begin(), N, result.begin());
+
+		return result;
+	}
+
+
+	// Western (Gregorian) Easter Sunday, the anonymous Gregorian algorithm
+	// (the same dates as gregorian::make_Easter, which is not constexpr)
+	constexpr auto _make_Easter(const std::chrono::year& y) -> std::chrono::year_month_day
+	{
+		const auto Y = static_cast<int>(y);
+		const auto a = Y % 19;
+		const auto b = Y / 100;
+		const auto c = Y % 100;
+		const auto d = b / 4;
+		const auto e = b % 4;
+		const auto f = (b + 8) / 25;
+		const auto g = (b - f + 1) / 3;
+		const auto h = (19 * a + b - d - g + 15) % 30;
+		const auto i = c / 4;
+		const auto k = c % 4;
+		const auto l = (32 + 2 * e + 2 * i - h - k) % 7;
+		const auto m = (a + 11 * h + 22 * l) / 451;
+		const auto n = h + l - 7 * m + 114;
+
+		return y / std::chrono::month{ static_cast<unsigned>(n / 31) } / std::chrono::day{ static_cast<unsigned>(n % 31 + 1) };
+	}
+
+
+	constexpr auto _england_from = std::chrono::year{ 2018 };
+	constexpr auto _england_until = std::chrono::year{ 2025 };
+
+	constexpr auto _make_england_holidays() -> _holiday_table_builder
+	{
+		// from https://www.gov.uk/bank-holidays
+
+		using namespace std::chrono;
+
+		auto result = _holiday_table_builder{};
+
+		for (auto y = _england_from; y <= _england_until; ++y)
+		{
+			const auto Easter = sys_days{ _make_Easter(y) };
+
+			result.add(y / January / day{ 1u });
+			result.add(Easter - days{ 2 }); // Good Friday
+			result.add(Easter + days{ 1 }); // Easter Monday
+
+			if (y == year{ 2020 })
+				result.add(y / May / day{ 8u }); // VE day instead of the Early May Bank Holiday
+			else
+				result.add(sys_days{ y / May / Monday[1] });
+
+			if (y == year{ 2022 })
+			{
+				result.add(y / June / day{ 2u }); // Spring Bank Holiday moved for the Platinum Jubilee
+				result.add(y / June / day{ 3u }); // Platinum Jubilee
+				result.add(y / September / day{ 19u }); // State Funeral of Queen Elizabeth II
+			}
+			else
+			{
+				result.add(sys_days{ y / May / Monday[last] });
+			}
+
+			if (y == year{ 2023 })
+				result.add(y / May / day{ 8u }); // coronation of King Charles III
+
+			result.add(sys_days{ y / August / Monday[last] });
+			result.add(y / December / day{ 25u });
+			result.add(y / December / day{ 26u });
+		}
+
+		result.finish();
+
+		return result;
+	}
+
+	inline constexpr auto _england_holidays = _make_england_holidays();
+	inline constexpr auto england_holidays = _shrink<_england_holidays._size>(_england_holidays);
+
+
+	constexpr auto _TARGET2_from = std::chrono::year{ 2002 };
+	constexpr auto _TARGET2_until = std::chrono::year{ 2023 };
+
+	constexpr auto _make_TARGET2_holidays() -> _holiday_table_builder
+	{
+		// from https://www.ecb.europa.eu/paym/target/target2/profuse/calendar/html/index.en.html
+
+		using namespace std::chrono;
+
+		auto result = _holiday_table_builder{};
+
+		for (auto y = _TARGET2_from; y <= _TARGET2_until; ++y)
+		{
+			const auto Easter = sys_days{ _make_Easter(y) };
+
+			result.add(y / January / day{ 1u });
+			result.add(Easter - days{ 2 }); // Good Friday
+			result.add(Easter + days{ 1 }); // Easter Monday
+			result.add(y / May / day{ 1u }); // Labour Day
+			result.add(y / December / day{ 25u });
+			result.add(y / December / day{ 26u });
+		}
+
+		result.finish();
+
+		return result;
+	}
+
+	inline constexpr auto _TARGET2_holidays = _make_TARGET2_holidays();
+	inline constexpr auto TARGET2_holidays = _shrink<_TARGET2_holidays._size>(_TARGET2_holidays);
+
+
+	constexpr auto _SIX_from = std::chrono::year{ 1999 };
+	constexpr auto _SIX_until = std::chrono::year{ 2024 };
+
+	constexpr auto _make_SIX_holidays() -> _holiday_table_builder
+	{
+		// from https://www.six-group.com/en/products-services/the-swiss-stock-exchange/market-data/news-tools/trading-currency-holiday-calendar.html#/
+
+		using namespace std::chrono;
+
+		auto result = _holiday_table_builder{};
+
+		for (auto y = _SIX_from; y <= _SIX_until; ++y)
+		{
+			const auto Easter = sys_days{ _make_Easter(y) };
+
+			result.add(y / January / day{ 1u });
+			result.add(y / January / day{ 2u }); // Berchtold's Day
+			result.add(Easter - days{ 2 }); // Good Friday
+			result.add(Easter + days{ 1 }); // Easter Monday
+			result.add(y / May / day{ 1u }); // Labour Day (sometimes the same day as Ascension Day)
+			result.add(Easter + days{ 39 }); // Ascension Day
+			result.add(Easter + days{ 50 }); // Whit Monday
+			result.add(y / August / day{ 1u }); // National Day
+			result.add(y / December / day{ 25u });
+			result.add(y / December / day{ 26u });
+		}
+
+		result.finish();
+
+		return result;
+	}
+
+	inline constexpr auto _SIX_holidays = _make_SIX_holidays();
+	inline constexpr auto SIX_holidays = _shrink<_SIX_holidays._size>(_SIX_holidays);
+
+
+	template<std::size_t N>
+	auto _make_holiday_schedule(
+		const std::array<std::chrono::year_month_day, N>& holidays,
+		const std::chrono::year& from,
+		const std::chrono::year& until
+	) -> gregorian::schedule
+	{
+		// the table is sorted, so the storage is filled without any searching
+		return {
+			{ from / std::chrono::January / std::chrono::day{ 1u }, until / std::chrono::December / std::chrono::day{ 31u } },
+			{ holidays.cbegin(), holidays.cend() }
+		};
+	}
+
+	// England (for SONIA, usually used with substitution of the weekend holidays)
+	inline auto make_england_holiday_schedule() -> gregorian::schedule
+	{
+		return _make_holiday_schedule(england_holidays, _england_from, _england_until);
+	}
+
+	// TARGET2 (for EuroSTR)
+	inline auto make_TARGET2_holiday_schedule() -> gregorian::schedule
+	{
+		return _make_holiday_schedule(TARGET2_holidays, _TARGET2_from, _TARGET2_until);
+	}
+
+	// SIX (for SARON)
+	inline auto make_SIX_holiday_schedule() -> gregorian::schedule
+	{
+		return _make_holiday_schedule(SIX_holidays, _SIX_from, _SIX_until);
+	}
+
+}
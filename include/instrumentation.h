@@ -0,0 +1,172 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <round.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace risk_free_rate
+{
+
+	// counters and timers for the builders and for what they spend time on
+	// (compiled out unless RISK_FREE_RATE_INSTRUMENTATION is defined, see the CMake option with the same name)
+
+#ifdef RISK_FREE_RATE_INSTRUMENTATION
+	constexpr auto instrumentation_enabled = true;
+#else
+	constexpr auto instrumentation_enabled = false;
+#endif
+
+
+	enum class instrumented : std::size_t
+	{
+		// builders
+		compound,
+		make_compounded_index,
+		make_compounded_rate,
+
+		// operations inside them
+		calendar_lookup,
+		day_count_fraction,
+		compounding_schedule,
+		rounding,
+
+		_size
+	};
+
+
+	struct instrumentation_counter
+	{
+		std::uint64_t _count;
+		std::chrono::nanoseconds _time; // including anything nested (for example calendar lookups in a builder)
+	};
+
+	struct instrumentation_stats
+	{
+		instrumentation_counter _compound;
+		instrumentation_counter _make_compounded_index; // make_compounded_index2 and appends as well
+		instrumentation_counter _make_compounded_rate;
+
+		instrumentation_counter _calendar_lookups;
+		instrumentation_counter _day_count_fractions;
+		instrumentation_counter _compounding_schedules;
+		instrumentation_counter _roundings;
+	};
+
+
+	// process wide, so builders running in parallel are counted as well
+	inline auto _instrumentation_counts = std::array<std::atomic<std::uint64_t>, static_cast<std::size_t>(instrumented::_size)>{};
+	inline auto _instrumentation_nanoseconds = std::array<std::atomic<std::int64_t>, static_cast<std::size_t>(instrumented::_size)>{};
+
+
+	// (all zeros if instrumentation is not enabled)
+	inline auto get_instrumentation_stats() noexcept -> instrumentation_stats
+	{
+		const auto get = [](const instrumented what) noexcept {
+			const auto i = static_cast<std::size_t>(what);
+
+			return instrumentation_counter{
+				_instrumentation_counts[i].load(std::memory_order_relaxed),
+				std::chrono::nanoseconds{ _instrumentation_nanoseconds[i].load(std::memory_order_relaxed) }
+			};
+		};
+
+		return instrumentation_stats{
+			get(instrumented::compound),
+			get(instrumented::make_compounded_index),
+			get(instrumented::make_compounded_rate),
+			get(instrumented::calendar_lookup),
+			get(instrumented::day_count_fraction),
+			get(instrumented::compounding_schedule),
+			get(instrumented::rounding)
+		};
+	}
+
+	inline auto reset_instrumentation_stats() noexcept -> void
+	{
+		for (auto& c : _instrumentation_counts)
+			c.store(0u, std::memory_order_relaxed);
+		for (auto& t : _instrumentation_nanoseconds)
+			t.store(0, std::memory_order_relaxed);
+	}
+
+
+	// counts and times its own lifetime
+	class _instrumentation_scope final
+	{
+
+	public:
+
+		explicit _instrumentation_scope(const instrumented what) noexcept;
+
+		_instrumentation_scope(const _instrumentation_scope&) = delete;
+		auto operator=(const _instrumentation_scope&) -> _instrumentation_scope& = delete;
+
+		~_instrumentation_scope();
+
+	private:
+
+		instrumented _what;
+		std::chrono::steady_clock::time_point _start;
+
+	};
+
+
+	inline _instrumentation_scope::_instrumentation_scope(const instrumented what) noexcept :
+		_what{ what },
+		_start{}
+	{
+		if constexpr (instrumentation_enabled)
+			_start = std::chrono::steady_clock::now();
+	}
+
+	inline _instrumentation_scope::~_instrumentation_scope()
+	{
+		if constexpr (instrumentation_enabled)
+		{
+			const auto elapsed = std::chrono::steady_clock::now() - _start;
+			const auto i = static_cast<std::size_t>(_what);
+
+			_instrumentation_counts[i].fetch_add(1u, std::memory_order_relaxed);
+			_instrumentation_nanoseconds[i].fetch_add(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+				std::memory_order_relaxed
+			);
+		}
+	}
+
+
+	inline auto _round(const double x, const unsigned decimal_places) -> double
+	{
+		const auto scope = _instrumentation_scope{ instrumented::rounding };
+
+		return round(x, decimal_places);
+	}
+
+}
@@ -23,15 +23,24 @@
 #pragma once
 
 #include "compounded_rate.h" // is this the right way around?
+#include "serial_date.h"
 
 #include <compounding_schedule.h>
 
 #include <business_day_convention_interface.h>
+#include <business_day_conventions.h>
+#include <period.h>
 #include <calendar.h>
 
 #include <chrono>
 #include <memory>
 #include <vector>
+#include <array>
+#include <span>
+#include <utility>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
 
 
 namespace risk_free_rate
@@ -70,7 +79,7 @@ namespace risk_free_rate
 	}
 
 
-	inline auto _middle(const std::vector<std::chrono::year_month_day>& es) noexcept -> std::chrono::year_month_day
+	inline auto _middle(std::span<const std::chrono::year_month_day> es) noexcept -> std::chrono::year_month_day
 	{
 		// For each end date with several possible start dates according to the CHF money market calendar, the following 
 		// applies(unless the end date is the last business day of a month :
@@ -93,17 +102,22 @@ namespace risk_free_rate
 
 		// does it cover all possibilities? (also assuming non SIX calendars)
 		// could it be speed up / simplified?
-		auto es = std::vector<std::chrono::year_month_day>{};
-		for (auto d = std::chrono::sys_days{ ymd } - std::chrono::days{ 4 };
-			d <= std::chrono::sys_days{ ymd } + std::chrono::days{ 4 };
-			d += std::chrono::days{ 1 }
-		)
+		// (the scan is in serial dates and each candidate is converted to year_month_day once, for the calendar,
+		// and there are at most 9 candidates, so they do not need to be allocated)
+		auto candidates = std::array<std::chrono::year_month_day, 9u>{};
+		auto size = std::size_t{ 0u };
+		const auto s = to_serial(ymd);
+		for (auto d = s - 4; d <= s + 4; ++d)
 		{
-			if(cal.is_business_day(d))
-				if(make_maturity(d, _term, &gregorian::ModifiedFollowing, cal) == _maturity)
-					es.push_back(d);
+			const auto candidate = from_serial(d);
+
+			if(cal.is_business_day(candidate))
+				if(make_maturity(candidate, _term, &gregorian::ModifiedFollowing, cal) == _maturity)
+					candidates[size++] = candidate;
 		}
 
+		const auto es = std::span<const std::chrono::year_month_day>{ candidates.data(), size };
+
 		if (es.empty())
 			// If the originally calculated start date falls on a non - business day or non - existent date(e.g. 30th of February), the
 			// business day preceding the calculated start date will be the used as the start date, unless this new start date
@@ -117,7 +131,121 @@ namespace risk_free_rate
 			else
 				return _middle(es);
 	}
-	// should we use serial dates here?
+
+
+
+	// the same start dates as inverse_modified_following gives, but precomputed for all maturities in a period
+	// (built once per calendar and term, rather than scanning around each start date again and again)
+	class inverse_modified_following_table final
+	{
+
+	public:
+
+		explicit inverse_modified_following_table(
+			const gregorian::calendar& cal,
+			std::chrono::months term,
+			gregorian::days_period maturities
+		);
+
+	public:
+
+		auto make_effective(const std::chrono::year_month_day& maturity) const -> std::chrono::year_month_day;
+
+	public:
+
+		auto get_term() const noexcept -> const std::chrono::months&;
+		auto get_period() const noexcept -> const gregorian::days_period&;
+
+	private:
+
+		std::chrono::months _term;
+
+		gregorian::days_period _maturities;
+
+		std::vector<serial_date> _effective; // for each calendar day in _maturities
+
+	};
+
+
+	inline inverse_modified_following_table::inverse_modified_following_table(
+		const gregorian::calendar& cal,
+		std::chrono::months term,
+		gregorian::days_period maturities
+	) :
+		_term{ std::move(term) },
+		_maturities{ std::move(maturities) },
+		_effective{}
+	{
+		const auto from = std::chrono::sys_days{ _maturities.get_from() };
+		const auto until = std::chrono::sys_days{ _maturities.get_until() };
+
+		// ModifiedFollowing maturity of each business day which can be a start date for one of the maturities
+		// (inverted by sorting on the maturity)
+		auto maturity_start = std::vector<std::pair<std::chrono::sys_days, std::chrono::sys_days>>{};
+		for (auto d = std::chrono::sys_days{ _make_ok(_maturities.get_from() - _term) } - std::chrono::days{ 4 };
+			d <= std::chrono::sys_days{ _make_ok(_maturities.get_until() - _term) } + std::chrono::days{ 4 };
+			d += std::chrono::days{ 1 }
+		)
+		{
+			if (cal.is_business_day(d))
+				maturity_start.emplace_back(make_maturity(d, _term, &gregorian::ModifiedFollowing, cal), d);
+		}
+		std::sort(maturity_start.begin(), maturity_start.end());
+
+		_effective.reserve((until - from).count() + 1);
+		for (auto m = from; m <= until; m += std::chrono::days{ 1 })
+		{
+			const auto maturity = std::chrono::year_month_day{ m };
+			const auto ymd = _make_ok(maturity - _term);
+
+			auto effective = std::chrono::year_month_day{};
+
+			if (maturity == make_last_business_day(maturity.year() / maturity.month(), cal))
+				effective = make_last_business_day(ymd.year() / ymd.month(), cal);
+			else
+			{
+				// only start dates within 4 days of the unadjusted one count (exactly as in the scan above)
+				const auto lo = std::lower_bound(
+					maturity_start.cbegin(),
+					maturity_start.cend(),
+					std::pair{ m, std::chrono::sys_days{ ymd } - std::chrono::days{ 4 } }
+				);
+				const auto hi = std::upper_bound(
+					lo,
+					maturity_start.cend(),
+					std::pair{ m, std::chrono::sys_days{ ymd } + std::chrono::days{ 4 } }
+				);
+
+				const auto size = static_cast<std::size_t>(hi - lo);
+				if (size == 0u)
+					effective = gregorian::ModifiedPreceding.adjust(ymd, cal);
+				else
+					// the unique one, the middle one or the earlier of the two middle ones (see _middle above)
+					effective = (lo + (size - 1u) / 2u)->second;
+			}
+
+			_effective.push_back(to_serial(effective));
+		}
+	}
+
+
+	inline auto inverse_modified_following_table::make_effective(const std::chrono::year_month_day& maturity) const -> std::chrono::year_month_day
+	{
+		const auto i = to_serial(maturity) - to_serial(_maturities.get_from());
+
+		return from_serial(_effective.at(static_cast<std::size_t>(i))); // throws if maturity is outside of the period
+	}
+
+
+	inline auto inverse_modified_following_table::get_term() const noexcept -> const std::chrono::months&
+	{
+		return _term;
+	}
+
+	inline auto inverse_modified_following_table::get_period() const noexcept -> const gregorian::days_period&
+	{
+		return _maturities;
+	}
 
 	// are EOM (and last-business day) is something orthogonal to business_day_convention and both are needed separately?
 
@@ -0,0 +1,142 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <cstddef>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+
+namespace risk_free_rate
+{
+
+	// read only view of the whole file
+	// (memory mapped on POSIX systems, read into a buffer elsewhere)
+	class mapped_file final
+	{
+
+	public:
+
+		explicit mapped_file(const std::string& file_name);
+
+		mapped_file(const mapped_file&) = delete;
+		auto operator=(const mapped_file&) -> mapped_file& = delete;
+
+		~mapped_file();
+
+	public:
+
+		auto view() const noexcept -> std::string_view;
+
+	private:
+
+		const char* _data;
+		std::size_t _size;
+
+#if !(defined(__unix__) || defined(__APPLE__))
+		std::string _buffer;
+#endif
+
+	};
+
+
+#if defined(__unix__) || defined(__APPLE__)
+
+	inline mapped_file::mapped_file(const std::string& file_name) :
+		_data{ nullptr },
+		_size{ 0u }
+	{
+		const auto fd = ::open(file_name.c_str(), O_RDONLY);
+		if (fd == -1)
+			throw std::runtime_error{ "Cannot open " + file_name };
+
+		struct ::stat st;
+		if (::fstat(fd, &st) == -1)
+		{
+			::close(fd);
+			throw std::runtime_error{ "Cannot stat " + file_name };
+		}
+
+		_size = static_cast<std::size_t>(st.st_size);
+		if (_size != 0u) // mmap does not accept empty mappings
+		{
+			const auto p = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (p == MAP_FAILED)
+			{
+				::close(fd);
+				throw std::runtime_error{ "Cannot map " + file_name };
+			}
+
+			::madvise(p, _size, MADV_SEQUENTIAL);
+
+			_data = static_cast<const char*>(p);
+		}
+
+		::close(fd); // the mapping stays valid
+	}
+
+	inline mapped_file::~mapped_file()
+	{
+		if (_data)
+			::munmap(const_cast<char*>(_data), _size);
+	}
+
+#else
+
+	inline mapped_file::mapped_file(const std::string& file_name) :
+		_data{ nullptr },
+		_size{ 0u },
+		_buffer{}
+	{
+		auto fs = std::ifstream{ file_name, std::ios::binary };
+		if (!fs)
+			throw std::runtime_error{ "Cannot open " + file_name };
+
+		_buffer.assign(std::istreambuf_iterator<char>{ fs }, std::istreambuf_iterator<char>{});
+
+		_data = _buffer.data();
+		_size = _buffer.size();
+	}
+
+	inline mapped_file::~mapped_file() = default;
+
+#endif
+
+
+	inline auto mapped_file::view() const noexcept -> std::string_view
+	{
+		return { _data, _size };
+	}
+
+}
@@ -0,0 +1,345 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "mapped_file.h"
+
+#include <round.h>
+#include <resets.h>
+
+#include <day_count_interface.h>
+#include <day_counts.h>
+
+#include <period.h>
+#include <time_series.h>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <memory>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace risk_free_rate
+{
+
+	// binary snapshot of resets (or of any series stored as resets, like a compounded index):
+	// a fixed header, then a value for each calendar day of the period (0.0 if missing)
+	// and then a bitmap of the days which have a value
+	// (all in the byte order of the machine which wrote it)
+
+	constexpr auto _snapshot_magic = std::string_view{ "RFRSNAP", 8u }; // including the terminating zero
+	constexpr auto _snapshot_version = std::uint32_t{ 1u };
+	constexpr auto _snapshot_byte_order = std::uint32_t{ 0x01020304u };
+
+	struct _snapshot_header
+	{
+		char _magic[8];
+		std::uint32_t _version;
+		std::uint32_t _byte_order;
+		std::int32_t _from; // days since 1970-01-01
+		std::int32_t _until;
+		std::uint32_t _day_count;
+		std::uint32_t _reserved;
+		std::uint64_t _size; // number of calendar days in the period
+		std::uint64_t _checksum; // of everything after the header
+	};
+
+	static_assert(sizeof(_snapshot_header) == 48u); // so the values which follow are aligned
+
+
+	// only day counts which we can find again in the reader are supported
+	inline auto _snapshot_day_count_id(const coupon_schedule::day_count* const dc) -> std::uint32_t
+	{
+		if (dc == &coupon_schedule::Actual360)
+			return 1u;
+		else if (dc == &coupon_schedule::Actual365Fixed)
+			return 2u;
+		else
+			throw std::invalid_argument{ "Day count is not supported in snapshots" };
+	}
+
+	inline auto _snapshot_day_count(const std::uint32_t id) -> const coupon_schedule::day_count*
+	{
+		switch (id)
+		{
+		case 1u:
+			return &coupon_schedule::Actual360;
+		case 2u:
+			return &coupon_schedule::Actual365Fixed;
+		default:
+			throw std::runtime_error{ "Unknown day count in snapshot" };
+		}
+	}
+
+	inline auto _snapshot_bitmap_words(const std::size_t size) noexcept -> std::size_t
+	{
+		return (size + 63u) / 64u;
+	}
+
+	// FNV-1a over 64 bit words rather than bytes (the payload is always a whole number of words)
+	inline auto _snapshot_checksum(const char* data, const std::size_t size) noexcept -> std::uint64_t
+	{
+		auto h = std::uint64_t{ 14695981039346656037u };
+		for (auto i = std::size_t{ 0u }; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+		{
+			auto word = std::uint64_t{};
+			std::memcpy(&word, data + i, sizeof(word));
+
+			h ^= word;
+			h *= std::uint64_t{ 1099511628211u };
+		}
+
+		return h;
+	}
+
+
+	inline auto write_snapshot(const resets& r, const std::string& file_name) -> void
+	{
+		const auto& ts = r.get_time_series();
+		const auto& period = ts.get_period();
+
+		const auto from = std::chrono::sys_days{ period.get_from() };
+		const auto until = std::chrono::sys_days{ period.get_until() };
+		const auto size = static_cast<std::size_t>((until - from).count() + 1);
+
+		auto values = std::vector<double>(size, 0.0);
+		auto bitmap = std::vector<std::uint64_t>(_snapshot_bitmap_words(size), 0u);
+		for (auto i = std::size_t{ 0u }; i < size; ++i)
+		{
+			const auto& o = ts[from + std::chrono::days{ i }];
+			if (o)
+			{
+				values[i] = *o;
+				bitmap[i / 64u] |= std::uint64_t{ 1u } << (i % 64u);
+			}
+		}
+
+		const auto values_bytes = values.size() * sizeof(double);
+		const auto bitmap_bytes = bitmap.size() * sizeof(std::uint64_t);
+
+		auto payload = std::vector<char>(values_bytes + bitmap_bytes);
+		std::memcpy(payload.data(), values.data(), values_bytes);
+		std::memcpy(payload.data() + values_bytes, bitmap.data(), bitmap_bytes);
+
+		auto header = _snapshot_header{};
+		std::memcpy(header._magic, _snapshot_magic.data(), _snapshot_magic.size());
+		header._version = _snapshot_version;
+		header._byte_order = _snapshot_byte_order;
+		header._from = static_cast<std::int32_t>(from.time_since_epoch().count());
+		header._until = static_cast<std::int32_t>(until.time_since_epoch().count());
+		header._day_count = _snapshot_day_count_id(r.get_day_count());
+		header._reserved = 0u;
+		header._size = size;
+		header._checksum = _snapshot_checksum(payload.data(), payload.size());
+
+		auto fs = std::ofstream{ file_name, std::ios::binary | std::ios::trunc };
+		fs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		fs.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+		if (!fs)
+			throw std::runtime_error{ "Cannot write " + file_name };
+	}
+
+
+
+	// read only resets straight from a memory mapped snapshot
+	// (nothing is parsed or copied when the snapshot is opened, apart from the checksum verification)
+	class resets_view final
+	{
+
+	public:
+
+		explicit resets_view(const std::string& file_name);
+
+	public:
+
+		// the same as resets::operator[] (throws if the reset is missing)
+		auto operator[](const std::chrono::year_month_day& ymd) const -> double;
+
+		// observation as stored (i.e. as a percentage for rates)
+		auto get_observation(const std::chrono::year_month_day& ymd) const -> std::optional<double>;
+
+		auto last_reset_year_month_day() const -> std::chrono::year_month_day;
+
+		auto get_period() const noexcept -> const gregorian::days_period&;
+		auto get_day_count() const noexcept -> const coupon_schedule::day_count*;
+
+		// a copy which can be used with the builders (which expect resets)
+		auto to_resets() const -> resets;
+
+	private:
+
+		auto _index(const std::chrono::year_month_day& ymd) const -> std::size_t;
+		auto _contains(const std::size_t i) const noexcept -> bool;
+		auto _value(const std::size_t i) const noexcept -> double;
+
+	private:
+
+		std::unique_ptr<const mapped_file> _file; // so the view can be moved
+
+		gregorian::days_period _period;
+
+		const coupon_schedule::day_count* _day_count;
+
+		std::size_t _size;
+		const char* _values;
+		const char* _bitmap;
+
+	};
+
+
+	inline resets_view::resets_view(const std::string& file_name) :
+		_file{ std::make_unique<const mapped_file>(file_name) },
+		_period{ {}, {} },
+		_day_count{ nullptr },
+		_size{ 0u },
+		_values{ nullptr },
+		_bitmap{ nullptr }
+	{
+		const auto data = _file->view();
+
+		auto header = _snapshot_header{};
+		if (data.size() < sizeof(header))
+			throw std::runtime_error{ "Snapshot is too short: " + file_name };
+
+		std::memcpy(&header, data.data(), sizeof(header));
+
+		if (std::string_view{ header._magic, sizeof(header._magic) } != _snapshot_magic)
+			throw std::runtime_error{ "Not a snapshot: " + file_name };
+		if (header._version != _snapshot_version)
+			throw std::runtime_error{ "Unsupported snapshot version: " + file_name };
+		if (header._byte_order != _snapshot_byte_order)
+			throw std::runtime_error{ "Snapshot was written with a different byte order: " + file_name };
+
+		// the size comes from the file, so it is checked against the length before anything is multiplied by it
+		// (otherwise a crafted size could overflow the number of bytes below and still match the length)
+		if (header._size > (data.size() - sizeof(header)) / sizeof(double))
+			throw std::runtime_error{ "Snapshot has unexpected size: " + file_name };
+
+		_size = static_cast<std::size_t>(header._size);
+
+		const auto values_bytes = _size * sizeof(double);
+		const auto bitmap_bytes = _snapshot_bitmap_words(_size) * sizeof(std::uint64_t);
+		if (data.size() != sizeof(header) + values_bytes + bitmap_bytes)
+			throw std::runtime_error{ "Snapshot has unexpected size: " + file_name };
+
+		_values = data.data() + sizeof(header);
+		_bitmap = _values + values_bytes;
+
+		if (_snapshot_checksum(_values, values_bytes + bitmap_bytes) != header._checksum)
+			throw std::runtime_error{ "Snapshot checksum does not match: " + file_name };
+
+		const auto from = std::chrono::sys_days{ std::chrono::days{ header._from } };
+		const auto until = std::chrono::sys_days{ std::chrono::days{ header._until } };
+		if (static_cast<std::size_t>((until - from).count() + 1) != _size)
+			throw std::runtime_error{ "Snapshot period does not match its size: " + file_name };
+
+		_period = gregorian::days_period{ from, until };
+		_day_count = _snapshot_day_count(header._day_count);
+	}
+
+
+	inline auto resets_view::operator[](const std::chrono::year_month_day& ymd) const -> double
+	{
+		const auto i = _index(ymd);
+		if (!_contains(i))
+			throw std::out_of_range{ "Reset is missing" };
+
+		return from_percent(_value(i));
+	}
+
+	inline auto resets_view::get_observation(const std::chrono::year_month_day& ymd) const -> std::optional<double>
+	{
+		const auto i = _index(ymd);
+		if (!_contains(i))
+			return std::nullopt;
+
+		return _value(i);
+	}
+
+	inline auto resets_view::last_reset_year_month_day() const -> std::chrono::year_month_day
+	{
+		for (auto i = _size; i > 0u; --i)
+			if (_contains(i - 1u))
+				return std::chrono::sys_days{ _period.get_from() } + std::chrono::days{ i - 1u };
+
+		throw std::out_of_range{ "No resets" };
+	}
+
+
+	inline auto resets_view::get_period() const noexcept -> const gregorian::days_period&
+	{
+		return _period;
+	}
+
+	inline auto resets_view::get_day_count() const noexcept -> const coupon_schedule::day_count*
+	{
+		return _day_count;
+	}
+
+
+	inline auto resets_view::to_resets() const -> resets
+	{
+		auto ts = resets::storage{ _period };
+
+		const auto from = std::chrono::sys_days{ _period.get_from() };
+		for (auto i = std::size_t{ 0u }; i < _size; ++i)
+			if (_contains(i))
+				ts[from + std::chrono::days{ i }] = _value(i);
+
+		return resets{ std::move(ts), _day_count };
+	}
+
+
+	inline auto resets_view::_index(const std::chrono::year_month_day& ymd) const -> std::size_t
+	{
+		const auto i = std::chrono::sys_days{ ymd } - std::chrono::sys_days{ _period.get_from() };
+		if (i.count() < 0 || ymd > _period.get_until())
+			throw std::out_of_range{ "Date is outside of the snapshot" };
+
+		return static_cast<std::size_t>(i.count());
+	}
+
+	inline auto resets_view::_contains(const std::size_t i) const noexcept -> bool
+	{
+		auto word = std::uint64_t{};
+		std::memcpy(&word, _bitmap + (i / 64u) * sizeof(std::uint64_t), sizeof(word));
+
+		return (word >> (i % 64u)) & 1u;
+	}
+
+	inline auto resets_view::_value(const std::size_t i) const noexcept -> double
+	{
+		auto x = 0.0;
+		std::memcpy(&x, _values + i * sizeof(double), sizeof(x));
+
+		return x;
+	}
+
+}
@@ -0,0 +1,347 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "compounding_conventions.h"
+
+#include <resets.h>
+
+#include <compounding_schedule.h>
+
+#include <period.h>
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <type_traits>
+#include <limits>
+#include <stdexcept>
+#include <cstddef>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+
+namespace risk_free_rate
+{
+
+	// resets under a number of scenarios (for example shocked overnight rates for VaR)
+	// stored day by day, with all scenarios of a day next to each other
+	class scenario_resets final
+	{
+
+	public:
+
+		// every scenario starts as a copy of the base resets
+		// (a reset missing in the base is missing in all the scenarios)
+		explicit scenario_resets(const resets& base, const std::size_t scenarios);
+
+	public:
+
+		// rate as a decimal (i.e. what resets::operator[] returns, not a percentage)
+		// (throws if the reset is missing, the same as resets::operator[])
+		auto operator()(const std::chrono::year_month_day& ymd, const std::size_t scenario) const -> double;
+		auto operator()(const std::chrono::year_month_day& ymd, const std::size_t scenario) -> double&;
+
+		// rates of all scenarios for a given day (throws if the reset is missing)
+		auto row(const std::chrono::year_month_day& ymd) const -> const double*;
+
+		auto get_period() const noexcept -> const gregorian::days_period&;
+		auto get_scenarios() const noexcept -> std::size_t;
+		auto get_day_count() const noexcept -> const coupon_schedule::day_count*;
+
+	private:
+
+		auto _offset(const std::chrono::year_month_day& ymd) const -> std::size_t;
+
+		// the same as _offset, but throws if the reset is missing
+		auto _reset_offset(const std::chrono::year_month_day& ymd) const -> std::size_t;
+
+	private:
+
+		gregorian::days_period _period;
+
+		std::size_t _scenarios;
+
+		const coupon_schedule::day_count* _day_count;
+
+		std::vector<double> _rates;
+
+		std::vector<bool> _missing; // for each day of the period
+
+	};
+
+
+	inline scenario_resets::scenario_resets(const resets& base, const std::size_t scenarios) :
+		_period{ base.get_time_series().get_period() },
+		_scenarios{ scenarios },
+		_day_count{ base.get_day_count() },
+		_rates{},
+		_missing{}
+	{
+		const auto& ts = base.get_time_series();
+		const auto days = std::chrono::sys_days{ _period.get_until() } - std::chrono::sys_days{ _period.get_from() };
+
+		_rates.reserve((days.count() + 1) * _scenarios);
+		_missing.reserve(days.count() + 1);
+		for (auto d = std::chrono::sys_days{ _period.get_from() }; d <= std::chrono::sys_days{ _period.get_until() }; d += std::chrono::days{ 1 })
+		{
+			const auto rate = ts[d] ? base[d] : std::numeric_limits<double>::quiet_NaN(); // never read
+			_rates.insert(_rates.end(), _scenarios, rate);
+			_missing.push_back(!ts[d]);
+		}
+	}
+
+
+	inline auto scenario_resets::operator()(const std::chrono::year_month_day& ymd, const std::size_t scenario) const -> double
+	{
+		return _rates[_reset_offset(ymd) + scenario];
+	}
+
+	inline auto scenario_resets::operator()(const std::chrono::year_month_day& ymd, const std::size_t scenario) -> double&
+	{
+		return _rates[_reset_offset(ymd) + scenario];
+	}
+
+	inline auto scenario_resets::row(const std::chrono::year_month_day& ymd) const -> const double*
+	{
+		return _rates.data() + _reset_offset(ymd);
+	}
+
+
+	inline auto scenario_resets::get_period() const noexcept -> const gregorian::days_period&
+	{
+		return _period;
+	}
+
+	inline auto scenario_resets::get_scenarios() const noexcept -> std::size_t
+	{
+		return _scenarios;
+	}
+
+	inline auto scenario_resets::get_day_count() const noexcept -> const coupon_schedule::day_count*
+	{
+		return _day_count;
+	}
+
+
+	inline auto scenario_resets::_offset(const std::chrono::year_month_day& ymd) const -> std::size_t
+	{
+		const auto i = std::chrono::sys_days{ ymd } - std::chrono::sys_days{ _period.get_from() };
+		if (i.count() < 0 || ymd > _period.get_until())
+			throw std::out_of_range{ "Date is outside of the scenario resets" };
+
+		return static_cast<std::size_t>(i.count()) * _scenarios;
+	}
+
+	inline auto scenario_resets::_reset_offset(const std::chrono::year_month_day& ymd) const -> std::size_t
+	{
+		const auto offset = _offset(ymd);
+
+		if (_missing[static_cast<std::size_t>((std::chrono::sys_days{ ymd } - std::chrono::sys_days{ _period.get_from() }).count())])
+			throw std::out_of_range{
+				"reset is missing " +
+				std::to_string(static_cast<int>(ymd.year())) + "-" +
+				std::to_string(static_cast<unsigned>(ymd.month())) + "-" +
+				std::to_string(static_cast<unsigned>(ymd.day()))
+			};
+
+		return offset;
+	}
+
+
+	// kernels for c[s] *= 1.0 + r[s] * year_fraction for all scenarios
+	// (multiplication and addition are kept separate, so every lane matches the scalar compound() bit for bit:
+	// gcc contracts them into fma across statements, and target("avx512f") alone is enough for it to emit vfmadd,
+	// so each kernel is compiled with fp-contract=off, while clang contracts only within an expression,
+	// which the pragma at the start of each kernel turns off - this way the flags of the users are not touched,
+	// and compound() itself is not contracted unless it is built for a CPU with fma, -mfma or -march=native)
+	// the vector ones are compiled whatever flags the library is built with and picked at run time,
+	// depending on what the CPU supports
+	enum class _scenario_kernel
+	{
+		scalar,
+		avx2,
+		avx512
+	};
+
+
+#if defined(__GNUC__) && !defined(__clang__)
+	__attribute__((optimize("fp-contract=off")))
+#endif
+	inline auto _compound_scenarios_scalar(double* c, const double* r, const double year_fraction, const std::size_t scenarios) noexcept -> void
+	{
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#endif
+		for (auto s = std::size_t{ 0u }; s < scenarios; ++s)
+			c[s] *= 1.0 + r[s] * year_fraction;
+	}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+
+#if defined(__clang__)
+	__attribute__((target("avx2")))
+#else
+	__attribute__((target("avx2"), optimize("fp-contract=off")))
+#endif
+	inline auto _compound_scenarios_avx2(double* c, const double* r, const double year_fraction, const std::size_t scenarios) noexcept -> void
+	{
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#endif
+		auto s = std::size_t{ 0u };
+
+		const auto one = _mm256_set1_pd(1.0);
+		const auto f = _mm256_set1_pd(year_fraction);
+		for (; s + 4u <= scenarios; s += 4u)
+		{
+			const auto factor = _mm256_add_pd(one, _mm256_mul_pd(_mm256_loadu_pd(r + s), f));
+			_mm256_storeu_pd(c + s, _mm256_mul_pd(_mm256_loadu_pd(c + s), factor));
+		}
+
+		for (; s < scenarios; ++s)
+			c[s] *= 1.0 + r[s] * year_fraction;
+	}
+
+#if defined(__clang__)
+	__attribute__((target("avx512f")))
+#else
+	__attribute__((target("avx512f"), optimize("fp-contract=off")))
+#endif
+	inline auto _compound_scenarios_avx512(double* c, const double* r, const double year_fraction, const std::size_t scenarios) noexcept -> void
+	{
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#endif
+		auto s = std::size_t{ 0u };
+
+		const auto one = _mm512_set1_pd(1.0);
+		const auto f = _mm512_set1_pd(year_fraction);
+		for (; s + 8u <= scenarios; s += 8u)
+		{
+			const auto factor = _mm512_add_pd(one, _mm512_mul_pd(_mm512_loadu_pd(r + s), f));
+			_mm512_storeu_pd(c + s, _mm512_mul_pd(_mm512_loadu_pd(c + s), factor));
+		}
+
+		for (; s < scenarios; ++s)
+			c[s] *= 1.0 + r[s] * year_fraction;
+	}
+
+#endif
+
+
+	inline auto _supports(const _scenario_kernel kernel) noexcept -> bool
+	{
+		switch (kernel)
+		{
+		case _scenario_kernel::scalar:
+			return true;
+#if defined(__x86_64__) && defined(__GNUC__)
+		case _scenario_kernel::avx2:
+			return __builtin_cpu_supports("avx2");
+		case _scenario_kernel::avx512:
+			return __builtin_cpu_supports("avx512f");
+#endif
+		default:
+			return false;
+		}
+	}
+
+	inline auto _best_scenario_kernel() noexcept -> _scenario_kernel
+	{
+		static const auto kernel =
+			_supports(_scenario_kernel::avx512) ? _scenario_kernel::avx512 :
+			_supports(_scenario_kernel::avx2) ? _scenario_kernel::avx2 :
+			_scenario_kernel::scalar;
+
+		return kernel;
+	}
+
+	// (the kernel should be supported by the CPU)
+	inline auto _compound_scenarios(
+		double* c,
+		const double* r,
+		const double year_fraction,
+		const std::size_t scenarios,
+		const _scenario_kernel kernel = _best_scenario_kernel()
+	) noexcept -> void
+	{
+		switch (kernel)
+		{
+#if defined(__x86_64__) && defined(__GNUC__)
+		case _scenario_kernel::avx512:
+			_compound_scenarios_avx512(c, r, year_fraction, scenarios);
+			break;
+		case _scenario_kernel::avx2:
+			_compound_scenarios_avx2(c, r, year_fraction, scenarios);
+			break;
+#endif
+		default:
+			_compound_scenarios_scalar(c, r, year_fraction, scenarios);
+			break;
+		}
+	}
+
+
+	template<typename DayCount>
+	auto _compound(const DayCount& dc, const coupon_schedule::compounding_periods& periods, const scenario_resets& resets) -> std::vector<double>
+	{
+		const auto scenarios = resets.get_scenarios();
+
+		auto c = std::vector<double>(scenarios, 1.0);
+		for (const auto& p : periods)
+		{
+			const auto year_fraction = dc.fraction(p._period);
+			const auto r = resets.row(p._reset);
+
+			if constexpr (std::is_same_v<DayCount, business_252_day_count>)
+				for (auto s = std::size_t{ 0u }; s < scenarios; ++s)
+					c[s] *= _growth(dc, r[s], year_fraction); // not simple interest, so not vectorised above
+			else
+				_compound_scenarios(c.data(), r, year_fraction, scenarios);
+		}
+
+		const auto full_period = gregorian::period{
+			periods.front()._period.get_from(),
+			periods.back()._period.get_until()
+		};
+
+		const auto full_year_fraction = dc.fraction(full_period);
+		for (auto& x : c)
+			x = _rate(dc, x, full_year_fraction);
+
+		return c;
+	}
+
+	// compounded rate for each scenario (the same as calling compound() for each scenario separately)
+	inline auto compound(const coupon_schedule::compounding_periods& periods, const scenario_resets& resets) -> std::vector<double>
+	{
+		return _visit_day_count(
+			resets.get_day_count(),
+			[&](const auto& dc) { return _compound(dc, periods, resets); }
+		);
+	}
+
+}
@@ -0,0 +1,58 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+
+namespace risk_free_rate
+{
+
+	// days since 1970-01-01 (the same as sys_days)
+	// the loops in this library work with these internally, as every conversion from year_month_day
+	// (and even more so back to it) costs a number of divisions - year_month_day is only used
+	// where we have to talk to the calendar and the resets (or return the results)
+	using serial_date = std::int32_t;
+
+
+	inline auto to_serial(const std::chrono::sys_days& d) noexcept -> serial_date
+	{
+		return static_cast<serial_date>(d.time_since_epoch().count());
+	}
+
+	inline auto to_serial(const std::chrono::year_month_day& ymd) noexcept -> serial_date
+	{
+		return to_serial(std::chrono::sys_days{ ymd });
+	}
+
+	inline auto to_sys_days(const serial_date d) noexcept -> std::chrono::sys_days
+	{
+		return std::chrono::sys_days{ std::chrono::days{ d } };
+	}
+
+	inline auto from_serial(const serial_date d) noexcept -> std::chrono::year_month_day
+	{
+		return std::chrono::year_month_day{ to_sys_days(d) };
+	}
+
+}
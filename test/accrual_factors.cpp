@@ -0,0 +1,145 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "setup.h"
+
+#include <accrual_factors.h>
+#include <compounded_index.h>
+#include <compounded_rate.h>
+
+#include <day_counts.h>
+#include <compounding_schedule.h>
+
+#include <period.h>
+#include <time_series.h>
+#include <weekend.h>
+#include <schedule.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(accrual_factors, compound)
+	{
+		const auto resets_period = period{ 2018y / April / 2d, 2018y / April / 6d };
+		const auto index_period = period{ 2018y / April / 2d, 2018y / April / 9d };
+
+		auto ts = resets::storage{ resets_period };
+		ts[2018y / April / 2d] = 1.80;
+		ts[2018y / April / 3d] = 1.83;
+		ts[2018y / April / 4d] = 1.74;
+		ts[2018y / April / 5d] = 1.75;
+		ts[2018y / April / 6d] = 1.75;
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto c = calendar{
+			SaturdaySundayWeekend,
+			schedule{ index_period, {} }
+		};
+
+		const auto factors = accrual_factors{ r, 2018y / April / 2d, c };
+
+		EXPECT_EQ(index_period, factors.get_period());
+		EXPECT_EQ(6u, factors.get_dates().size());
+		EXPECT_EQ(5u, factors.get_factors().size());
+
+		EXPECT_NEAR(0.018, factors.compound(2018y / April / 2d, 2018y / April / 3d), 0.000001);
+		EXPECT_NEAR(0.0183, factors.compound(2018y / April / 3d, 2018y / April / 4d), 0.000001);
+
+		// weekends are mapped to the next business day
+		EXPECT_EQ(factors.slot(2018y / April / 9d), factors.slot(2018y / April / 7d));
+	}
+
+	TEST(accrual_factors, compound_saron)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		const auto factors = accrual_factors{ r, from, publication };
+
+		const auto term = months{ 3 };
+		for (const auto& maturity : factors.get_dates())
+		{
+			const auto effective = make_effective(maturity, term, &ModifiedPreceding, publication);
+			if (effective >= from)
+			{
+				const auto schedule = make_compounding_schedule({ { effective, maturity }, maturity, maturity }, publication);
+
+				// the order of multiplications is different, so results are not bitwise the same
+				const auto expected = compound(schedule, r);
+				EXPECT_NEAR(expected, factors.compound(effective, maturity), 1e-14);
+			}
+		}
+	}
+
+	TEST(accrual_factors, make_compounded_index2)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto decimal_places = 6u;
+		const auto starting_value = 10'000.0;
+
+		const auto factors = accrual_factors{ r, from, publication };
+
+		const auto expected = make_compounded_index2(r, from, publication, decimal_places, starting_value);
+		const auto ci = make_compounded_index2(factors, decimal_places, starting_value);
+
+		EXPECT_EQ(expected.get_time_series(), ci.get_time_series());
+	}
+
+}
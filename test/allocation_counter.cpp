@@ -0,0 +1,211 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+
+// the whole set of replaceable allocation functions, so that every form is counted
+// and every pointer is released by the function matching the one which allocated it
+// (kept in a translation unit of its own, so that nothing here is inlined into the tests)
+
+namespace
+{
+
+	auto _allocations = std::atomic<std::size_t>{ 0u };
+
+
+	auto _allocate(const std::size_t size) -> void*
+	{
+		_allocations.fetch_add(1u, std::memory_order_relaxed);
+
+		if (const auto p = std::malloc(size == 0u ? 1u : size))
+			return p;
+
+		throw std::bad_alloc{};
+	}
+
+	auto _allocate(const std::size_t size, const std::align_val_t alignment) -> void*
+	{
+		_allocations.fetch_add(1u, std::memory_order_relaxed);
+
+		// aligned_alloc needs the size to be a multiple of the alignment
+		const auto a = static_cast<std::size_t>(alignment);
+		const auto s = ((size == 0u ? 1u : size) + a - 1u) / a * a;
+
+		if (const auto p = std::aligned_alloc(a, s))
+			return p;
+
+		throw std::bad_alloc{};
+	}
+
+	auto _deallocate(void* p) noexcept -> void
+	{
+		std::free(p);
+	}
+
+}
+
+
+namespace risk_free_rate
+{
+
+	auto allocation_count() noexcept -> std::size_t
+	{
+		return _allocations.load(std::memory_order_relaxed);
+	}
+
+}
+
+
+auto operator new(std::size_t size) -> void*
+{
+	return _allocate(size);
+}
+
+auto operator new[](std::size_t size) -> void*
+{
+	return _allocate(size);
+}
+
+auto operator new(std::size_t size, const std::nothrow_t&) noexcept -> void*
+{
+	try
+	{
+		return _allocate(size);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+auto operator new[](std::size_t size, const std::nothrow_t&) noexcept -> void*
+{
+	try
+	{
+		return _allocate(size);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment) -> void*
+{
+	return _allocate(size, alignment);
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment) -> void*
+{
+	return _allocate(size, alignment);
+}
+
+auto operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept -> void*
+{
+	try
+	{
+		return _allocate(size, alignment);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+auto operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept -> void*
+{
+	try
+	{
+		return _allocate(size, alignment);
+	}
+	catch (...)
+	{
+		return nullptr;
+	}
+}
+
+
+auto operator delete(void* p) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete[](void* p) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete(void* p, std::size_t) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete[](void* p, std::size_t) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete(void* p, const std::nothrow_t&) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete[](void* p, const std::nothrow_t&) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete(void* p, std::align_val_t) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete[](void* p, std::align_val_t) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete(void* p, std::size_t, std::align_val_t) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete[](void* p, std::size_t, std::align_val_t) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete(void* p, std::align_val_t, const std::nothrow_t&) noexcept -> void
+{
+	_deallocate(p);
+}
+
+auto operator delete[](void* p, std::align_val_t, const std::nothrow_t&) noexcept -> void
+{
+	_deallocate(p);
+}
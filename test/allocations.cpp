@@ -0,0 +1,76 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "setup.h"
+#include "allocation_counter.h"
+
+#include <compounded_rate.h>
+
+#include <day_counts.h>
+
+#include <weekend.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(allocations, make_compounded_rate)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		const auto allocations = [&](const year_month_day& from) {
+			const auto before = allocation_count();
+			const auto cr = make_compounded_rate(months{ 3 }, r, from, &ModifiedPreceding, publication, 4u);
+
+			return allocation_count() - before;
+		};
+
+		// the number of allocations does not depend on the number of dates
+		EXPECT_EQ(allocations(2022y / June / 30d), allocations(2000y / June / 30d));
+	}
+
+}
@@ -0,0 +1,159 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "setup.h"
+
+#include <bitset_calendar.h>
+#include <compounding_conventions.h>
+#include <compounded_index.h>
+#include <compounded_rate.h>
+
+#include <day_counts.h>
+#include <compounding_schedule.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <type_traits>
+#include <cmath>
+#include <stdexcept>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	// the calendar is not copied, so it cannot be a temporary
+	static_assert(is_constructible_v<bitset_calendar, const calendar&, days_period>);
+	static_assert(!is_constructible_v<bitset_calendar, calendar, days_period>);
+
+	TEST(bitset_calendar, TARGET2)
+	{
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+
+		const auto from_until = days_period{ 2019y / January / 1d, 2023y / December / 31d };
+		const auto bitset = bitset_calendar{ publication, from_until };
+
+		const auto from = sys_days{ from_until.get_from() };
+		auto count = size_t{ 0u };
+		for (auto d = from; d <= sys_days{ from_until.get_until() }; d += days{ 1 })
+		{
+			EXPECT_EQ(publication.is_business_day(d), bitset.is_business_day(d));
+			EXPECT_EQ(make_overnight_maturity(d, publication), bitset.next_business_day(d));
+			EXPECT_EQ(count, bitset.count_business_days(from, d));
+
+			if (publication.is_business_day(d))
+				++count;
+		}
+		EXPECT_EQ(count, bitset.count_business_days(from_until.get_from(), 2024y / January / 1d));
+
+		EXPECT_EQ(21u, bitset.count_business_days(2022y / December / 1d, 2023y / January / 1d)); // 26th is a holiday
+		EXPECT_EQ(0u, bitset.count_business_days(2022y / December / 24d, 2022y / December / 27d));
+		EXPECT_EQ(make_overnight_maturity(2023y / December / 29d, publication), bitset.next_business_day(2023y / December / 29d)); // after the period
+		EXPECT_THROW(bitset.is_business_day(2024y / January / 1d), out_of_range);
+		EXPECT_THROW(bitset.count_business_days(2022y / December / 2d, 2022y / December / 1d), invalid_argument);
+	}
+
+	TEST(bitset_calendar, make_compounded_index)
+	{
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 2019y / October / 1d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+		const auto bitset = bitset_calendar{ publication, { 2019y / January / 1d, 2023y / December / 31d } };
+		const auto decimal_places = 8u;
+
+		const auto expected = make_compounded_index(r, from, publication, decimal_places);
+		const auto ci = make_compounded_index(r, from, bitset, decimal_places);
+
+		EXPECT_EQ(expected.get_time_series(), ci.get_time_series());
+	}
+
+	TEST(bitset_calendar, business_252)
+	{
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+		const auto bitset = bitset_calendar{ publication, { 2021y / January / 1d, 2023y / December / 31d } };
+		const auto bus252 = business_252{ bitset };
+
+		EXPECT_EQ(bitset.count_business_days(2021y / January / 4d, 2022y / January / 3d) / 252.0, bus252.fraction({ 2021y / January / 4d, 2022y / January / 3d }));
+
+		// CDI like rates (in %), which change every month
+		const auto from = 2021y / January / 4d;
+		const auto until = 2022y / December / 30d;
+		auto ts = resets::storage{ { from, until } };
+		for (auto d = sys_days{ from }; d <= sys_days{ until }; d += days{ 1 })
+			if (publication.is_business_day(d))
+				ts[d] = 2.0 + static_cast<unsigned>(year_month_day{ d }.month()) * 0.75;
+
+		const auto r = resets{ ts, &bus252 };
+
+		// each overnight period is one business day, so each daily factor is (1 + rate) ^ (1 / 252)
+		auto growth = 1.0;
+		auto n = 0u;
+		for (auto d = sys_days{ from }; d < sys_days{ until }; d = sys_days{ make_overnight_maturity(d, publication) })
+		{
+			growth *= pow(1.0 + *ts[d] / 100.0, 1.0 / 252.0);
+			++n;
+		}
+
+		const auto schedule = make_compounding_schedule({ { from, until }, until, until }, publication);
+		EXPECT_EQ(pow(growth, 252.0 / n) - 1.0, compound(schedule, r));
+		EXPECT_EQ(compound(schedule, r), compound(compounding_range{ from, until, bitset }, r));
+
+		const auto ci = make_compounded_index(r, from, bitset, 8u);
+		EXPECT_NEAR(100.0 * growth, *ci.get_time_series()[until], 1e-8);
+
+		// a constant rate compounds to itself
+		auto flat = resets::storage{ { from, until } };
+		for (auto d = sys_days{ from }; d <= sys_days{ until }; d += days{ 1 })
+			if (publication.is_business_day(d))
+				flat[d] = 13.65;
+
+		EXPECT_NEAR(0.1365, compound(schedule, resets{ move(flat), &bus252 }), 1e-14);
+	}
+
+}
@@ -0,0 +1,130 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "setup.h"
+
+#include <business_day_series.h>
+#include <dense_calendar.h>
+#include <compounded_index.h>
+#include <compounded_rate.h>
+#include <compounding_conventions.h>
+
+#include <day_counts.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <type_traits>
+#include <optional>
+#include <stdexcept>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	// the dense calendar is not copied, so it cannot be a temporary
+	static_assert(is_constructible_v<business_day_series, const dense_calendar&, days_period>);
+	static_assert(!is_constructible_v<business_day_series, dense_calendar, days_period>);
+	static_assert(!is_constructible_v<business_day_series, dense_calendar, const resets::storage&>);
+
+	TEST(business_day_series, constructor)
+	{
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto dense = dense_calendar{ publication, { 2018y / January / 1d, 2018y / December / 31d } };
+
+		auto s = business_day_series{ dense, { 2018y / March / 29d, 2018y / April / 9d } };
+		EXPECT_EQ(6u, s.size()); // Good Friday and Easter Monday
+
+		s[2018y / March / 29d] = 1.0;
+		s[2018y / April / 9d] = 2.0;
+		s[2018y / April / 3d] = optional<double>{};
+		EXPECT_EQ(1.0, as_const(s)[2018y / March / 29d]);
+		EXPECT_EQ(2.0, as_const(s)[2018y / April / 9d]);
+		EXPECT_FALSE(as_const(s)[2018y / April / 3d]);
+		EXPECT_FALSE(as_const(s)[2018y / March / 30d]);
+		EXPECT_FALSE(as_const(s)[2018y / April / 10d]);
+		EXPECT_THROW(s[2018y / March / 30d], out_of_range);
+
+		s[2018y / April / 9d] = nullopt;
+		EXPECT_FALSE(as_const(s)[2018y / April / 9d]);
+
+		auto ts = resets::storage{ { 2018y / March / 29d, 2018y / April / 9d } };
+		ts[2018y / April / 4d] = 3.0;
+		const auto s2 = business_day_series{ dense, ts };
+		EXPECT_EQ(ts, s2.to_storage());
+
+		ts[2018y / April / 2d] = 4.0; // Easter Monday
+		EXPECT_THROW((business_day_series{ dense, ts }), invalid_argument);
+	}
+
+	TEST(business_day_series, SARON)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto dense = dense_calendar{ publication, { 1999y / January / 1d, 2024y / December / 31d } };
+		const auto starting_value = 10'000.0;
+
+		const auto expected_index = make_compounded_index(SARONCompoundedIndexConvention, r, from, publication, starting_value);
+		const auto index = make_compounded_index_series(SARONCompoundedIndexConvention, r, from, dense, starting_value);
+		EXPECT_EQ(expected_index.get_time_series(), index.to_storage());
+
+		const auto term = months{ 3 };
+		const auto convention = &ModifiedPreceding;
+		const auto decimal_places = 4u;
+
+		const auto expected_rate = make_compounded_rate(term, r, from, convention, publication, decimal_places);
+		const auto rate = make_compounded_rate_series(term, r, from, convention, dense, decimal_places);
+		EXPECT_EQ(expected_rate.get_time_series(), rate.to_storage());
+
+		// at least half of the memory is saved
+		const auto& p = rate.get_period();
+		const auto days = sys_days{ p.get_until() } - sys_days{ p.get_from() } + std::chrono::days{ 1 };
+		EXPECT_LE(2u * rate.size_in_bytes(), days.count() * sizeof(optional<double>));
+	}
+
+}
@@ -0,0 +1,164 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "setup.h"
+
+#include <compound_tree.h>
+#include <compounded_rate.h>
+#include <accrual_factors.h>
+
+#include <day_counts.h>
+
+#include <compounding_schedule.h>
+#include <coupon_period.h>
+
+#include <business_day_conventions.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <vector>
+#include <execution>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(compound_tree, _tree_product)
+	{
+		EXPECT_EQ(1.0, _tree_product(execution::seq, span<const double>{}));
+
+		// 3 blocks: ((b0 * b1) * b2)
+		auto f = vector<double>(2u * _tree_leaf + 1u, 1.0);
+		f.front() = 2.0;
+		f[_tree_leaf] = 3.0;
+		f.back() = 5.0;
+		EXPECT_EQ(30.0, _tree_product(execution::seq, f));
+		EXPECT_EQ(30.0, _tree_product(execution::par, f));
+	}
+
+	TEST(compound_tree, SARON)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		const auto factors = accrual_factors{ r, from, publication };
+		const auto& dates = factors.get_dates();
+		const auto& f = factors.get_factors();
+
+		constexpr auto u = numeric_limits<double>::epsilon() / 2.0;
+
+		const auto sequential = [&](const size_t i, const size_t j)
+		{
+			auto c = 1.0;
+			for (auto k = i; k < j; ++k)
+				c *= f[k];
+
+			return c;
+		};
+
+		const auto bound = [&](const size_t n) { return (n + _tree_leaf + ceil(log2(n))) * u; };
+
+		// the whole history (since inception) - the shape of the tree does not depend on the policy
+		const auto schedule = make_compounding_schedule({ { dates.front(), dates.back() }, dates.back(), dates.back() }, publication);
+		const auto c = compound_tree(execution::seq, schedule, r);
+		EXPECT_EQ(c, compound_tree(execution::par, schedule, r));
+		EXPECT_EQ(c, compound_tree(execution::par_unseq, schedule, r));
+		EXPECT_EQ(c, compound_tree(execution::par, factors, dates.front(), dates.back()));
+		EXPECT_NEAR(compound(schedule, r), c, 1e-14);
+
+		const auto g = growth_tree(execution::par, factors, dates.front(), dates.back());
+		const auto s = sequential(0u, f.size());
+		EXPECT_LE(abs(g - s) / s, bound(f.size()));
+		EXPECT_LE(abs(g - s) / s, 1e-14); // 6.8e-15 as measured (and documented in compound_tree.h)
+
+		// 12M windows
+		auto worst = 0.0;
+		for (auto j = size_t{ 0u }; j < dates.size(); ++j)
+		{
+			const auto effective = make_effective(dates[j], months{ 12 }, &ModifiedPreceding, publication);
+			if (effective < from)
+				continue;
+
+			const auto i = factors.slot(effective);
+			const auto tree = growth_tree(execution::seq, factors, effective, dates[j]);
+			const auto seq = sequential(i, j);
+
+			const auto e = abs(tree - seq) / seq;
+			EXPECT_LE(e, bound(j - i));
+			worst = max(worst, e);
+		}
+		EXPECT_LE(worst, 5e-15); // 4.2e-15 as measured (and documented in compound_tree.h)
+	}
+
+	TEST(compound_tree, missing_reset)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+		ts[2022y / June / 1d] = nullopt;
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		const auto maturity = 2022y / September / 30d;
+		const auto schedule = make_compounding_schedule({ { 2022y / March / 31d, maturity }, maturity, maturity }, publication);
+
+		// the same as compound() (rather than terminating inside the parallel algorithm)
+		EXPECT_THROW(compound(schedule, r), out_of_range);
+		EXPECT_THROW(compound_tree(execution::par, schedule, r), out_of_range);
+		EXPECT_THROW(compound_tree(execution::par_unseq, schedule, r), out_of_range);
+	}
+
+}
@@ -0,0 +1,142 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "setup.h"
+
+#include <compounded_publication.h>
+#include <compounded_rates.h>
+#include <compounded_index.h>
+#include <compounding_conventions.h>
+
+#include <day_counts.h>
+
+#include <business_day_conventions.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(compounded_publication, EuroSTR)
+	{
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		const auto tenors = vector<tenor>{
+			{ weeks{ 1 }, &Preceding },
+			{ months{ 1 }, &ModifiedPreceding },
+			{ months{ 3 }, &ModifiedPreceding },
+			{ months{ 6 }, &ModifiedPreceding },
+			{ months{ 12 }, &ModifiedPreceding }
+		};
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 2019y / October / 1d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+		const auto decimal_places = 5u;
+
+		const auto pipeline = publication_pipeline{ EuroSTRCompoundedIndexConvention, tenors, decimal_places };
+		const auto p = pipeline.run(r, from, publication);
+
+		const auto ci = make_compounded_index(EuroSTRCompoundedIndexConvention, r, from, publication);
+		EXPECT_EQ(ci.get_time_series(), p._index.get_time_series());
+
+		const auto crs = make_compounded_rates(tenors, r, from, publication, decimal_places);
+		ASSERT_EQ(crs.size(), p._rates.size());
+		for (auto t = 0u; t < crs.size(); ++t)
+			EXPECT_EQ(crs[t].get_time_series(), p._rates[t].get_time_series());
+
+		// the day count of the resets has to be the one of the convention
+		const auto sonia = publication_pipeline{ SONIACompoundedIndexConvention, tenors, decimal_places };
+		EXPECT_THROW(sonia.run(r, from, publication), invalid_argument);
+	}
+
+	TEST(compounded_publication, SARON)
+	{
+		auto columns = parse_csv_columns(
+			SARON,
+			"Date"s,
+			{ "Swiss Average Rate ON", "SARON Index" },
+			';'
+		);
+
+		const auto tenors = vector<tenor>{
+			{ weeks{ 1 }, &Preceding },
+			tenor{ months{ 1 } },
+			tenor{ months{ 3 } },
+			tenor{ months{ 6 } },
+			tenor{ months{ 12 } }
+		};
+		const auto r = resets{ move(columns[0]), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto decimal_places = 4u;
+		const auto starting_value = 10'000.0;
+
+		const auto pipeline = publication_pipeline{ SARONCompoundedIndexConvention, tenors, decimal_places, starting_value };
+		const auto p = pipeline.run(r, from, publication);
+
+		const auto& expected = columns[1];
+		for (auto d = expected.get_period().get_from();
+			d <= expected.get_period().get_until();
+			d = sys_days{ d } + days{ 1 }
+		)
+		{
+			const auto& o = p._index.get_time_series()[d];
+
+			const auto& e = expected[d];
+			if (e)
+				EXPECT_EQ(*e, *o);
+			else
+				EXPECT_FALSE(o);
+		}
+
+		const auto crs = make_compounded_rates(tenors, r, from, publication, decimal_places);
+		ASSERT_EQ(crs.size(), p._rates.size());
+		for (auto t = 0u; t < crs.size(); ++t)
+			EXPECT_EQ(crs[t].get_time_series(), p._rates[t].get_time_series());
+	}
+
+}
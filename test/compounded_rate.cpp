@@ -24,6 +24,7 @@
 #include "setup.h"
 
 #include <compounded_rate.h>
+#include <compounded_rates.h>
 
 #include <day_counts.h>
 #include <compounding_schedule.h>
@@ -207,6 +208,47 @@ namespace risk_free_rate
 	}
 
 
+	TEST(compounded_rate, inverse_modified_following_table)
+	{
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		const auto maturities = period{ 2000y / January / 1d, 2023y / December / 31d };
+
+		for (const auto term : { months{ 1 }, months{ 2 }, months{ 3 }, months{ 6 }, months{ 9 }, months{ 12 } })
+		{
+			const auto table = inverse_modified_following_table{ publication, term, maturities };
+
+			for (auto maturity = sys_days{ maturities.get_from() }; maturity <= sys_days{ maturities.get_until() }; maturity += days{ 1 })
+			{
+				const auto convention = inverse_modified_following{ maturity, term };
+
+				EXPECT_EQ(make_effective(maturity, term, &convention, publication), table.make_effective(maturity));
+			}
+		}
+
+		const auto table = inverse_modified_following_table{ publication, months{ 1 }, maturities };
+		EXPECT_EQ(2018y / March / 22d, tenor{ &table }.make_effective(2018y / April / 23d, publication));
+	}
+
+	TEST(compounded_rate, tenor_make_effective)
+	{
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		const auto t1w = tenor{ weeks{ 1 }, &Preceding };
+		EXPECT_EQ(2018y / April / 16d, t1w.make_effective(2018y / April / 23d, publication));
+
+		const auto t1m = tenor{ months{ 1 } };
+		EXPECT_EQ(2018y / March / 22d, t1m.make_effective(2018y / April / 23d, publication));
+		EXPECT_EQ(2018y / September / 6d, t1m.make_effective(2018y / October / 8d, publication));
+	}
+
+
 	// add tests for make_maturity
 
 
@@ -0,0 +1,121 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <compounding_conventions.h>
+#include <compounded_index.h>
+
+#include <day_counts.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <stdexcept>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	// a day count with state (the calendar of Business/252) can not be made up from its type
+	static_assert(index_convention<compounded_index_convention<actual_360_day_count, rounding::output_only, 8u>>);
+	static_assert(!index_convention<compounded_index_convention<business_252_day_count, rounding::output_only, 8u>>);
+
+	TEST(compounding_conventions, day_counts)
+	{
+		const auto p = days_period{ 2023y / January / 31d, 2023y / March / 3d };
+
+		EXPECT_EQ(Actual360.fraction(p), actual_360_day_count::fraction(p));
+		EXPECT_EQ(Actual365Fixed.fraction(p), actual_365_fixed_day_count::fraction(p));
+
+		const auto from = to_serial(p.get_from());
+		const auto until = to_serial(p.get_until());
+		EXPECT_EQ(Actual360.fraction(p), actual_360_day_count::fraction(from, until));
+		EXPECT_EQ(Actual365Fixed.fraction(p), actual_365_fixed_day_count::fraction(from, until));
+		EXPECT_EQ(p.get_until(), from_serial(until));
+	}
+
+	TEST(compounding_conventions, EuroSTR)
+	{
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		auto hs = make_TARGET2_holiday_schedule();
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 2019y / October / 1d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+
+		const auto expected = make_compounded_index(r, from, publication, 8u);
+		const auto ci = make_compounded_index(EuroSTRCompoundedIndexConvention, r, from, publication);
+
+		EXPECT_EQ(expected.get_time_series(), ci.get_time_series());
+
+		// SONIA is Actual/365 Fixed, EuroSTR resets are Actual/360
+		EXPECT_THROW(make_compounded_index(SONIACompoundedIndexConvention, r, from, publication), invalid_argument);
+	}
+
+	TEST(compounding_conventions, SARON)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		auto hs = make_SIX_holiday_schedule();
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto starting_value = 10'000.0;
+
+		const auto expected = make_compounded_index2(r, from, publication, 6u, starting_value);
+		const auto ci = make_compounded_index(SARONCompoundedIndexConvention, r, from, publication, starting_value);
+
+		EXPECT_EQ(expected.get_time_series(), ci.get_time_series());
+	}
+
+}
@@ -0,0 +1,106 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <compounding_range.h>
+#include <compounded_rate.h>
+#include <dense_calendar.h>
+
+#include <day_counts.h>
+#include <compounding_schedule.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(compounding_range, fill_compounding_schedule)
+	{
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		auto scratch = compounding_periods{};
+		for (auto maturity = sys_days{ 2022y / January / 3d }; maturity <= sys_days{ 2022y / December / 30d }; maturity += days{ 1 })
+		{
+			const auto effective = make_effective(year_month_day{ maturity }, months{ 3 }, &ModifiedPreceding, publication);
+			const auto expected = make_compounding_schedule({ { effective, maturity }, maturity, maturity }, publication);
+
+			fill_compounding_schedule(compounding_range{ effective, year_month_day{ maturity }, publication }, scratch);
+
+			ASSERT_EQ(expected.size(), scratch.size());
+			for (auto i = 0u; i < expected.size(); ++i)
+			{
+				EXPECT_EQ(expected[i]._reset, scratch[i]._reset);
+				EXPECT_EQ(expected[i]._period, scratch[i]._period);
+			}
+		}
+	}
+
+	TEST(compounding_range, compound)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto dense = dense_calendar{ publication, { 1999y / January / 1d, 2024y / December / 31d } };
+
+		for (auto maturity = 2000y / January / 4d; maturity <= r.last_reset_year_month_day(); maturity = make_overnight_maturity(maturity, publication))
+		{
+			const auto effective = make_effective(maturity, months{ 1 }, &ModifiedPreceding, publication);
+			const auto schedule = make_compounding_schedule({ { effective, maturity }, maturity, maturity }, publication);
+
+			// bit for bit
+			const auto expected = compound(schedule, r);
+			EXPECT_EQ(expected, compound(compounding_range{ effective, maturity, publication }, r));
+			EXPECT_EQ(expected, compound(compounding_range{ effective, maturity, dense }, r));
+		}
+	}
+
+}
@@ -0,0 +1,147 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <concurrent_resets.h>
+
+#include <day_counts.h>
+
+#include <period.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(concurrent_resets, publish)
+	{
+		auto ts = resets::storage{ days_period{ 2023y / June / 1d, 2023y / June / 2d } };
+		ts[2023y / June / 1d] = 1.75;
+
+		auto cr = concurrent_resets{ resets{ move(ts), &Actual360 } };
+
+		const auto v0 = cr.snapshot();
+		cr.publish(2023y / June / 5d, 1.70);
+
+		// the old snapshot is not affected
+		EXPECT_EQ(2023y / June / 1d, v0->last_reset_year_month_day());
+		EXPECT_THROW((*v0)[2023y / June / 5d], out_of_range);
+
+		const auto v1 = cr.snapshot();
+		EXPECT_EQ(1u, v1->get_version());
+		EXPECT_EQ(v0->get_history(), v1->get_history()); // shared, rather than copied
+		EXPECT_EQ(2023y / June / 5d, v1->last_reset_year_month_day());
+		EXPECT_EQ(0.017, (*v1)[2023y / June / 5d]);
+		EXPECT_EQ(0.0175, (*v1)[2023y / June / 1d]);
+
+		const auto r = v1->to_resets();
+		EXPECT_EQ(2023y / June / 5d, r.last_reset_year_month_day());
+		EXPECT_EQ(0.017, r[2023y / June / 5d]);
+
+		EXPECT_THROW(cr.publish(2023y / May / 31d, 1.80), out_of_range);
+	}
+
+	// readers take snapshots while the SARON fixings of 2022-2023 are published one by one
+	static auto _stress(const unsigned reader_threads) -> void
+	{
+		const auto full = resets{
+			parse_csv(SARON, "Date"s, "Swiss Average Rate ON"s, ';'),
+			&Actual360
+		};
+		const auto& full_ts = full.get_time_series();
+
+		// pretend that we are back in 2022 and then receive the fixings one by one
+		const auto history_until = 2021y / December / 31d;
+		auto history = make_sub_storage(full_ts, { full_ts.get_period().get_from(), history_until });
+
+		auto fixings = vector<year_month_day>{};
+		for (auto d = sys_days{ history_until } + days{ 1 }; d <= sys_days{ full.last_reset_year_month_day() }; d += days{ 1 })
+			if (full_ts[d])
+				fixings.push_back(d);
+
+		auto cr = concurrent_resets{ resets{ move(history), &Actual360 } };
+
+		auto done = atomic<bool>{ false };
+		auto failures = atomic<unsigned>{ 0u };
+
+		auto readers = vector<jthread>{};
+		for (auto t = 0u; t < reader_threads; ++t)
+			readers.emplace_back([&] {
+				auto last_version = uint64_t{ 0u };
+				while (!done.load())
+				{
+					const auto s = cr.snapshot();
+
+					// each version is consistent: exactly "version" fixings published on top of the history
+					const auto v = s->get_version();
+					const auto expected_last = v == 0u ? year_month_day{ 2021y / December / 31d } : fixings[v - 1u];
+					if (v < last_version ||
+						s->last_reset_year_month_day() != expected_last ||
+						(*s)[expected_last] != full[expected_last])
+						failures.fetch_add(1u);
+
+					last_version = v;
+				}
+			});
+
+		for (const auto& d : fixings)
+			cr.publish(d, *full_ts[d]);
+
+		done.store(true);
+		readers.clear(); // joins
+
+		EXPECT_EQ(0u, failures.load());
+		EXPECT_EQ(fixings.size(), cr.snapshot()->get_version());
+		const auto expected = make_sub_storage(full_ts, { full_ts.get_period().get_from(), full.last_reset_year_month_day() });
+		EXPECT_EQ(expected, cr.snapshot()->to_resets().get_time_series());
+	}
+
+	// run with RISK_FREE_RATE_SANITIZE_THREAD=ON to check for data races
+	TEST(concurrent_resets, stress)
+	{
+		_stress(8u);
+	}
+
+	// more readers than slots, so some of them take snapshots without one
+	TEST(concurrent_resets, stress_overflow)
+	{
+		_stress(96u);
+	}
+
+}
@@ -0,0 +1,122 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <coupon_engine.h>
+#include <accrual_factors.h>
+#include <compounded_rate.h>
+
+#include <day_counts.h>
+#include <coupon_period.h>
+#include <compounding_schedule.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <execution>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	// quarterly coupons starting on each business day of a year, every one of them 3 times (as if from different trades)
+	inline auto _make_book(const calendar& publication) -> vector<coupon_period>
+	{
+		auto result = vector<coupon_period>{};
+		for (auto repeat = 0; repeat < 3; ++repeat)
+			for (auto effective = 2021y / January / 4d; effective <= 2021y / December / 31d; effective = make_overnight_maturity(effective, publication))
+			{
+				const auto maturity = make_maturity(effective, months{ 3 }, &ModifiedFollowing, publication);
+				result.emplace_back(days_period{ effective, maturity }, maturity, maturity);
+			}
+
+		return result;
+	}
+
+
+	TEST(coupon_engine, compound_coupons)
+	{
+		const auto eurostr = resets{
+			parse_csv(EuroSTR, "Period"s, "Volume-weighted trimmed mean rate"s),
+			&Actual360
+		};
+		const auto target2 = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+		const auto eurostr_factors = accrual_factors{ eurostr, 2019y / October / 1d, target2 };
+		const auto eurostr_book = _make_book(target2);
+
+		const auto saron = resets{
+			parse_csv(SARON, "Date"s, "Swiss Average Rate ON"s, ';'),
+			&Actual360
+		};
+		const auto six = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto saron_factors = accrual_factors{ saron, 2019y / October / 1d, six };
+		const auto saron_book = _make_book(six);
+
+		const auto batches = vector<coupon_batch>{
+			{ &eurostr_factors, eurostr_book },
+			{ &saron_factors, saron_book }
+		};
+
+		const auto rates = compound_coupons(execution::par, batches);
+		ASSERT_EQ(2u, rates.size());
+
+		// bit for bit the same as compound() on each coupon period
+		ASSERT_EQ(eurostr_book.size(), rates[0].size());
+		for (auto i = 0u; i < eurostr_book.size(); ++i)
+			EXPECT_EQ(compound(make_compounding_schedule(eurostr_book[i], target2), eurostr), rates[0][i]);
+
+		ASSERT_EQ(saron_book.size(), rates[1].size());
+		for (auto i = 0u; i < saron_book.size(); ++i)
+			EXPECT_EQ(compound(make_compounding_schedule(saron_book[i], six), saron), rates[1][i]);
+
+		EXPECT_EQ(rates[0], compound_coupons(eurostr_factors, eurostr_book));
+
+		// there is no rate over an empty accrual period
+		auto empty = vector<coupon_period>{};
+		empty.emplace_back(days_period{ 2021y / June / 1d, 2021y / June / 1d }, 2021y / June / 1d, 2021y / June / 1d);
+		EXPECT_THROW(compound_coupons(execution::par, eurostr_factors, empty), invalid_argument);
+	}
+
+}
@@ -0,0 +1,136 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "setup.h"
+
+#include <dense_calendar.h>
+#include <compounded_index.h>
+#include <compounded_rate.h>
+
+#include <day_counts.h>
+#include <compounding_schedule.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <type_traits>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	// the calendar is not copied, so it cannot be a temporary
+	static_assert(is_constructible_v<dense_calendar, const calendar&, days_period>);
+	static_assert(!is_constructible_v<dense_calendar, calendar, days_period>);
+
+	TEST(dense_calendar, SIX)
+	{
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+
+		const auto from_until = days_period{ 1999y / January / 1d, 2024y / December / 31d };
+		const auto dense = dense_calendar{ publication, from_until };
+
+		auto ordinal = 0u;
+		for (auto d = sys_days{ from_until.get_from() }; d <= sys_days{ from_until.get_until() }; d += days{ 1 })
+		{
+			EXPECT_EQ(publication.is_business_day(d), dense.is_business_day(d));
+			EXPECT_EQ(make_overnight_maturity(d, publication), dense.next_business_day(d));
+			EXPECT_EQ(Preceding.adjust(d - days{ 1 }, publication), dense.previous_business_day(d));
+			EXPECT_EQ(ordinal, dense.business_day_ordinal(d));
+			EXPECT_EQ(to_serial(dense.next_business_day(d)), dense.next_business_day(to_serial(d)));
+			EXPECT_EQ(to_serial(dense.previous_business_day(d)), dense.previous_business_day(to_serial(d)));
+
+			if (publication.is_business_day(d))
+				++ordinal;
+		}
+
+		EXPECT_EQ(2024y / December / 27d, dense.next_business_day(2024y / December / 24d));
+		EXPECT_THROW(dense.is_business_day(2025y / January / 1d), out_of_range);
+	}
+
+	TEST(dense_calendar, make_compounded_index2)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto dense = dense_calendar{ publication, { 1999y / January / 1d, 2024y / December / 31d } };
+		const auto decimal_places = 6u;
+		const auto starting_value = 10'000.0;
+
+		const auto expected = make_compounded_index2(r, from, publication, decimal_places, starting_value);
+		const auto ci = make_compounded_index2(r, from, dense, decimal_places, starting_value);
+
+		EXPECT_EQ(expected.get_time_series(), ci.get_time_series());
+	}
+
+	TEST(dense_calendar, make_compounded_rate)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto term = months{ 3 };
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto convention = &ModifiedPreceding;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto dense = dense_calendar{ publication, { 1999y / January / 1d, 2024y / December / 31d } };
+		const auto decimal_places = 4u;
+
+		const auto expected = make_compounded_rate(term, r, from, convention, publication, decimal_places);
+		const auto cr = make_compounded_rate(term, r, from, convention, dense, decimal_places);
+
+		EXPECT_EQ(expected.get_time_series(), cr.get_time_series());
+	}
+
+}
@@ -25,6 +25,7 @@
 #include <resets.h>
 #include <compounded_index.h>
 #include <compounded_rate.h>
+#include <compounded_rates.h>
 
 #include <day_counts.h>
 
@@ -37,6 +38,8 @@
 
 #include <chrono>
 #include <memory>
+#include <vector>
+#include <execution>
 
 
 using namespace coupon_schedule;
@@ -83,6 +86,42 @@ namespace risk_free_rate
 	}
 
 
+	TEST(eurostr, make_compounded_index_par)
+	{
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		auto hs = make_TARGET2_holiday_schedule();
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 2019y / October / 1d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 8u;
+		const auto ci = make_compounded_index(
+			execution::par,
+			r,
+			from,
+			publication,
+			decimal_places
+		);
+
+		EXPECT_EQ(make_compounded_index(r, from, publication, decimal_places).get_time_series(), ci.get_time_series());
+
+		const auto expected = parse_csv(
+			EuroSTRCompoundedIndex,
+			"Period"s,
+			"Compounded Euro Short-Term Rate Index, Index of compounded interest"s
+		);
+		EXPECT_EQ(expected, ci.get_time_series());
+	}
+
+
 	TEST(eurostr, make_compounded_rate_1w)
 	{
 		auto ts = parse_csv(
@@ -332,4 +371,172 @@ namespace risk_free_rate
 		}
 	}
 
+
+	TEST(eurostr, make_compounded_rate_rolling_12m)
+	{
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		auto hs = make_TARGET2_holiday_schedule();
+
+		const auto term = months{ 12 };
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 2019y / October / 1d;
+		const auto convention = &ModifiedPreceding;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 5u;
+		const auto cr = make_compounded_rate_rolling(
+			term,
+			r,
+			from,
+			convention,
+			publication,
+			decimal_places
+		);
+
+		const auto expected = parse_csv(
+			EuroSTRCompoundedRate,
+			"Period"s,
+			"Euro Short-Term Rate - 12-months Compounded Average Rate, Compounded average rate"s
+		);
+		for (auto d = expected.get_period().get_from();
+			d <= expected.get_period().get_until();
+			d = sys_days{ d } + days{ 1 }
+		)
+		{
+			const auto& o = cr.get_time_series()[d];
+
+			const auto& e = expected[d];
+			if (e)
+				EXPECT_EQ(*e, *o);
+			else
+				EXPECT_FALSE(o);
+		}
+	}
+
+
+	TEST(eurostr, make_compounded_rates)
+	{
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		auto hs = make_TARGET2_holiday_schedule();
+
+		const auto tenors = vector<tenor>{
+			{ weeks{ 1 }, &Preceding },
+			{ months{ 1 }, &ModifiedPreceding },
+			{ months{ 3 }, &ModifiedPreceding },
+			{ months{ 6 }, &ModifiedPreceding },
+			{ months{ 12 }, &ModifiedPreceding }
+		};
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 2019y / October / 1d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 5u;
+		const auto crs = make_compounded_rates(
+			tenors,
+			r,
+			from,
+			publication,
+			decimal_places
+		);
+
+		const auto columns = {
+			"Euro Short-Term Rate - 1-week Compounded Average Rate, Compounded average rate"s,
+			"Euro Short-Term Rate - 1-month Compounded Average Rate, Compounded average rate"s,
+			"Euro Short-Term Rate - 3-months Compounded Average Rate, Compounded average rate"s,
+			"Euro Short-Term Rate - 6-months Compounded Average Rate, Compounded average rate"s,
+			"Euro Short-Term Rate - 12-months Compounded Average Rate, Compounded average rate"s
+		};
+		ASSERT_EQ(columns.size(), crs.size());
+
+		auto cr = crs.cbegin();
+		for (const auto& column : columns)
+		{
+			const auto expected = parse_csv(
+				EuroSTRCompoundedRate,
+				"Period"s,
+				column
+			);
+			for (auto d = expected.get_period().get_from();
+				d <= expected.get_period().get_until();
+				d = sys_days{ d } + days{ 1 }
+			)
+			{
+				const auto& o = cr->get_time_series()[d];
+
+				const auto& e = expected[d];
+				if (e)
+					EXPECT_EQ(*e, *o);
+				else
+					EXPECT_FALSE(o);
+			}
+
+			++cr;
+		}
+	}
+
+
+	TEST(eurostr, append_compounded_index)
+	{
+		const auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		auto hs = make_TARGET2_holiday_schedule();
+
+		const auto from = 2019y / October / 1d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 8u;
+
+		// index as of the end of 2022 and then resets which arrived after that
+		const auto first = ts.get_period().get_from();
+		const auto last = ts.get_period().get_until();
+		const auto r2022 = resets{ make_sub_storage(ts, { first, 2022y / December / 30d }), &Actual360 };
+		const auto r2023 = resets{ make_sub_storage(ts, { 2023y / January / 2d, last }), &Actual360 };
+
+		auto state = compounded_index_state{ from, 100.0 };
+		const auto ci2022 = make_compounded_index(
+			r2022,
+			state,
+			publication,
+			decimal_places
+		);
+		EXPECT_EQ(2023y / January / 2d, state._date);
+
+		auto ci = compounded_index_series{ ci2022 };
+		append_compounded_index(
+			ci,
+			state,
+			r2023,
+			publication,
+			decimal_places
+		);
+
+		const auto expected = make_compounded_index(
+			resets{ ts, &Actual360 },
+			from,
+			publication,
+			decimal_places
+		);
+		EXPECT_EQ(expected.get_time_series(), ci.to_resets().get_time_series());
+	}
+
 }
@@ -0,0 +1,124 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <fixing_file.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+#include <string_view>
+
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(fixing_file, parse_date)
+	{
+		EXPECT_EQ(date_format::dd_mmm_yy, detect_date_format("01 Jun 23"));
+		EXPECT_EQ(date_format::yyyy_mm_dd, detect_date_format("2023-06-01"));
+		EXPECT_EQ(date_format::dd_mm_yyyy, detect_date_format("01.06.2023"));
+		EXPECT_THROW(detect_date_format("1 June 2023"), invalid_argument);
+
+		EXPECT_EQ(1997y / January / 2d, _parse_date("02 Jan 97", date_format::dd_mmm_yy));
+		EXPECT_EQ(2023y / June / 1d, _parse_date("01 Jun 23", date_format::dd_mmm_yy));
+		EXPECT_EQ(nullopt, _parse_date("31.02.2023", date_format::dd_mm_yyyy));
+	}
+
+	TEST(fixing_file, parse_decimal)
+	{
+		EXPECT_EQ(1.441654, _parse_decimal(" 1.441654"));
+		EXPECT_EQ(-0.0207, _parse_decimal("-0.02070"));
+		EXPECT_EQ(nullopt, _parse_decimal(""));
+		EXPECT_THROW(_parse_decimal("n/a"), invalid_argument);
+	}
+
+	TEST(fixing_file, load_fixings)
+	{
+		// the same as the original loader for all the files we have
+		const auto files = {
+			make_tuple(SONIA, "Date", "Daily Sterling overnight index average (SONIA) rate              [a] [b]             IUDSOIA", ','),
+			make_tuple(SONIACompoundedIndex, "Date", "SONIA Compounded Index              [a] [b] [c] [d]             IUDZOS2", ','),
+			make_tuple(EuroSTR, "Period", "Volume-weighted trimmed mean rate", ','),
+			make_tuple(EuroSTRCompoundedIndex, "Period", "Compounded Euro Short-Term Rate Index, Index of compounded interest", ','),
+			make_tuple(SARON, "Date", "Swiss Average Rate ON", ';'),
+			make_tuple(SARON, "Date", "SARON Index", ';'),
+			make_tuple(SARON, "Date", "Swiss Current Rate ON", ';'),
+			make_tuple(SARONCompoundedRate1W, "end_date", "value", ';'),
+			make_tuple(SARONCompoundedRate12M, "end_date", "value", ';')
+		};
+
+		for (const auto& [file, date, observation, separator] : files)
+			EXPECT_EQ(
+				parse_csv_rapidcsv(file, date, observation, separator),
+				load_fixings(file, date, observation, separator)
+			);
+
+		// with the date as the last column of a CRLF file
+		auto expected = resets::storage{ days_period{ 2023y / May / 30d, 2023y / June / 2d } };
+		expected[2023y / June / 2d] = 1.25;
+		expected[2023y / June / 1d] = 1.30;
+		expected[2023y / May / 30d] = 1.20;
+		EXPECT_EQ(expected, load_fixings("fixings_crlf.csv", "Date", "Rate"));
+
+		EXPECT_THROW(load_fixings(EuroSTR, "Period", "No such column"), invalid_argument);
+		EXPECT_THROW(load_fixings("no_such_file.csv", "Period", "Volume-weighted trimmed mean rate"), runtime_error);
+	}
+
+	TEST(fixing_file, load_fixings_columns)
+	{
+		const auto saron = vector<string_view>{
+			"Swiss Average Rate ON",
+			"SARON Index",
+			"Swiss Current Rate ON",
+			"Swiss Current Index ON"
+		};
+		const auto columns = load_fixings(SARON, "Date", saron, ';');
+		ASSERT_EQ(saron.size(), columns.size());
+		for (auto c = 0u; c < saron.size(); ++c)
+			EXPECT_EQ(load_fixings(SARON, "Date", saron[c], ';'), columns[c]);
+
+		// columns do not have to be requested in the order of the file
+		const auto eurostr = vector<string_view>{
+			"Euro Short-Term Rate - 12-months Compounded Average Rate, Compounded average rate",
+			"Compounded Euro Short-Term Rate Index, Index of compounded interest"
+		};
+		const auto index = load_fixings(EuroSTRCompoundedIndex, "Period", eurostr);
+		EXPECT_EQ(load_fixings(EuroSTRCompoundedIndex, "Period", eurostr[0]), index[0]);
+		EXPECT_EQ(load_fixings(EuroSTRCompoundedIndex, "Period", eurostr[1]), index[1]);
+
+		// a column can only go to one output, and the date column is not an observation
+		EXPECT_THROW(load_fixings(SARON, "Date", vector<string_view>{ "SARON Index", "Swiss Average Rate ON", "SARON Index" }, ';'), invalid_argument);
+		EXPECT_THROW(load_fixings(SARON, "Date", vector<string_view>{ "Swiss Average Rate ON", "Date" }, ';'), invalid_argument);
+	}
+
+}
@@ -0,0 +1,86 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "setup.h"
+
+#include <holiday_tables.h>
+
+#include <schedule.h>
+#include <annual_holidays.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <algorithm>
+
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	// the tables are there at compile time
+	static_assert(_make_Easter(2024y) == 2024y / March / 31d);
+	static_assert(_make_Easter(2019y) == 2019y / April / 21d);
+	static_assert(std::is_sorted(SIX_holidays.cbegin(), SIX_holidays.cend()));
+	static_assert(TARGET2_holidays.size() == 22u * 6u);
+	static_assert(SIX_holidays.front() == 1999y / January / 1d);
+
+
+	TEST(holiday_tables, make_Easter)
+	{
+		for (auto y = 1900y; y <= 2100y; ++y)
+			EXPECT_EQ(make_Easter(y), _make_Easter(y));
+	}
+
+	TEST(holiday_tables, england)
+	{
+		const auto expected = make_england_holiday_schedule_from_rules();
+		const auto hs = make_england_holiday_schedule();
+
+		EXPECT_EQ(expected.get_period(), hs.get_period());
+		EXPECT_EQ(expected.get_dates(), hs.get_dates());
+	}
+
+	TEST(holiday_tables, TARGET2)
+	{
+		const auto expected = make_TARGET2_holiday_schedule_from_rules();
+		const auto hs = make_TARGET2_holiday_schedule();
+
+		EXPECT_EQ(expected.get_period(), hs.get_period());
+		EXPECT_EQ(expected.get_dates(), hs.get_dates());
+	}
+
+	TEST(holiday_tables, SIX)
+	{
+		const auto expected = make_SIX_holiday_schedule_from_rules();
+		const auto hs = make_SIX_holiday_schedule();
+
+		EXPECT_EQ(expected.get_period(), hs.get_period());
+		EXPECT_EQ(expected.get_dates(), hs.get_dates());
+	}
+
+}
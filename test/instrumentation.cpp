@@ -0,0 +1,170 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <instrumentation.h>
+#include <compounded_index.h>
+#include <compounded_rate.h>
+
+#include <day_counts.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+#include <business_day_conventions.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <ranges>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	inline auto _published(const resets& r) -> uint64_t
+	{
+		const auto& ts = r.get_time_series();
+
+		auto result = uint64_t{ 0u };
+		for (auto d = ts.get_period().get_from(); d <= ts.get_period().get_until(); d = sys_days{ d } + days{ 1 })
+			if (ts[d])
+				++result;
+
+		return result;
+	}
+
+
+	TEST(instrumentation, make_compounded_index)
+	{
+		const auto r = resets{
+			parse_csv(EuroSTR, "Period"s, "Volume-weighted trimmed mean rate"s),
+			&Actual360
+		};
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+
+		reset_instrumentation_stats();
+		const auto ci = make_compounded_index(r, 2019y / October / 1d, publication, 8u);
+		const auto stats = get_instrumentation_stats();
+
+		if constexpr (instrumentation_enabled)
+		{
+			// one step for each published value, apart from the starting one
+			const auto steps = _published(ci) - 1u;
+
+			EXPECT_EQ(1u, stats._make_compounded_index._count);
+			EXPECT_EQ(steps + 1u, stats._calendar_lookups._count); // + the end of the index
+			EXPECT_EQ(steps, stats._day_count_fractions._count);
+			EXPECT_EQ(steps, stats._roundings._count);
+			EXPECT_EQ(0u, stats._compounding_schedules._count);
+			EXPECT_EQ(0u, stats._compound._count);
+			EXPECT_GT(stats._make_compounded_index._time, stats._calendar_lookups._time);
+		}
+		else
+		{
+			EXPECT_EQ(0u, stats._make_compounded_index._count);
+			EXPECT_EQ(0u, stats._calendar_lookups._count);
+		}
+	}
+
+	TEST(instrumentation, make_compounded_rate)
+	{
+		const auto r = resets{
+			parse_csv(EuroSTR, "Period"s, "Volume-weighted trimmed mean rate"s),
+			&Actual360
+		};
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+
+		reset_instrumentation_stats();
+		const auto cr = make_compounded_rate(months{ 1 }, r, 2019y / October / 1d, &ModifiedPreceding, publication, 5u);
+		const auto stats = get_instrumentation_stats();
+
+		if constexpr (instrumentation_enabled)
+		{
+			// each published rate is compounded (over periods generated on the fly) and rounded
+			const auto windows = _published(cr);
+
+			EXPECT_EQ(1u, stats._make_compounded_rate._count);
+			EXPECT_EQ(0u, stats._compounding_schedules._count); // nothing is materialised
+			EXPECT_EQ(windows, stats._compound._count);
+			EXPECT_EQ(windows, stats._roundings._count);
+			EXPECT_GT(stats._day_count_fractions._count, 10u * windows); // a daily fraction for each business day of the month
+		}
+		else
+		{
+			EXPECT_EQ(0u, stats._make_compounded_rate._count);
+			EXPECT_EQ(0u, stats._compounding_schedules._count);
+		}
+	}
+
+
+	TEST(instrumentation, compounded_rate_view)
+	{
+		const auto r = resets{
+			parse_csv(EuroSTR, "Period"s, "Volume-weighted trimmed mean rate"s),
+			&Actual360
+		};
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+
+		const auto view = compounded_rate_view{ months{ 1 }, r, 2019y / October / 1d, &ModifiedPreceding, publication, 5u };
+
+		reset_instrumentation_stats();
+		auto published = 0u;
+		for (const auto& [maturity, rate] : view.starting_at(2022y / June / 1d) | views::take(3))
+			if (rate)
+				++published;
+		const auto stats = get_instrumentation_stats();
+
+		EXPECT_EQ(3u, published);
+		if constexpr (instrumentation_enabled)
+		{
+			// only the windows we looked at are compounded (getting to the 1st of June only walks the calendar)
+			EXPECT_EQ(3u, stats._compound._count);
+			EXPECT_EQ(3u, stats._roundings._count);
+		}
+		else
+		{
+			EXPECT_EQ(0u, stats._compound._count);
+		}
+	}
+
+}
@@ -0,0 +1,161 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <resets_snapshot.h>
+#include <compounded_index.h>
+
+#include <day_counts.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(resets_snapshot, SARON)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+
+		const auto file_name = (filesystem::temp_directory_path() / "SARON.rfr").string();
+		write_snapshot(r, file_name);
+
+		const auto view = resets_view{ file_name };
+		EXPECT_EQ(&Actual360, view.get_day_count());
+		EXPECT_EQ(r.get_time_series().get_period(), view.get_period());
+		EXPECT_EQ(r.last_reset_year_month_day(), view.last_reset_year_month_day());
+
+		const auto& period = view.get_period();
+		for (auto d = period.get_from(); d <= period.get_until(); d = sys_days{ d } + days{ 1 })
+		{
+			EXPECT_EQ(r.get_time_series()[d], view.get_observation(d));
+			if (view.get_observation(d))
+				EXPECT_EQ(r[d], view[d]);
+			else
+				EXPECT_THROW(view[d], out_of_range);
+		}
+
+		EXPECT_EQ(r.get_time_series(), view.to_resets().get_time_series());
+
+		// compounded index is just another series
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_SIX_holiday_schedule()
+		};
+		const auto ci = make_compounded_index2(r, 1999y / June / 30d, publication, 6u, 10'000.0);
+		write_snapshot(ci, file_name);
+		EXPECT_EQ(ci.get_time_series(), resets_view{ file_name }.to_resets().get_time_series());
+
+		filesystem::remove(file_name);
+	}
+
+	TEST(resets_snapshot, corrupted)
+	{
+		auto ts = resets::storage{ days_period{ 2023y / June / 1d, 2023y / June / 2d } };
+		ts[2023y / June / 1d] = 1.75;
+		const auto ts_copy = ts;
+
+		const auto file_name = (filesystem::temp_directory_path() / "corrupted.rfr").string();
+		write_snapshot(resets{ move(ts), &Actual365Fixed }, file_name);
+		EXPECT_EQ(&Actual365Fixed, resets_view{ file_name }.get_day_count());
+
+		{
+			auto fs = fstream{ file_name, ios::binary | ios::in | ios::out };
+			fs.seekp(-1, ios::end);
+			fs.put('\x7f');
+		}
+		EXPECT_THROW(resets_view{ file_name }, runtime_error);
+
+		// a size for which the number of bytes overflows into exactly the length of the file:
+		// size = 64 * c - j days take 520 * c - 8 * j bytes, so we need 65 * c = payload / 8 + j modulo 2^61
+		// (65 has an inverse) with c small enough for the size to fit into 64 bits
+		write_snapshot(resets{ ts_copy, &Actual365Fixed }, file_name);
+		{
+			const auto payload = static_cast<uint64_t>(filesystem::file_size(file_name) - sizeof(_snapshot_header));
+
+			auto inverse = uint64_t{ 65u };
+			for (auto i = 0; i < 5; ++i)
+				inverse *= 2u - 65u * inverse;
+
+			auto size = uint64_t{ 0u };
+			for (auto j = uint64_t{ 0u }; j < 64u && size == 0u; ++j)
+			{
+				const auto c = ((payload / 8u + j) * inverse) & ((uint64_t{ 1u } << 61u) - 1u);
+				if (c < (uint64_t{ 1u } << 58u) && 64u * c > j)
+					size = 64u * c - j;
+			}
+			ASSERT_NE(0u, size);
+			ASSERT_EQ(payload, size * 8u + (size + 63u) / 64u * 8u); // wraps around
+
+			auto fs = fstream{ file_name, ios::binary | ios::in | ios::out };
+			fs.seekp(offsetof(_snapshot_header, _size));
+			fs.write(reinterpret_cast<const char*>(&size), sizeof(size));
+		}
+		try
+		{
+			const auto view = resets_view{ file_name };
+			ADD_FAILURE() << "no exception";
+		}
+		catch (const runtime_error& e)
+		{
+			EXPECT_NE(string_view{ e.what() }.find("unexpected size"), string_view::npos) << e.what();
+		}
+
+		{
+			auto fs = ofstream{ file_name, ios::binary | ios::trunc };
+			fs << "Date,SONIA\n";
+		}
+		EXPECT_THROW(resets_view{ file_name }, runtime_error);
+
+		filesystem::remove(file_name);
+	}
+
+}
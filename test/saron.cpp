@@ -37,6 +37,8 @@
 
 #include <chrono>
 #include <memory>
+#include <execution>
+#include <ranges>
 #include <calendar.h>
 
 
@@ -103,12 +105,13 @@ namespace risk_free_rate
 
 	TEST(saron, SwissCurrentRateON) // better name?
 	{
-		auto ts = parse_csv(
+		auto columns = parse_csv_columns(
 			SARON,
 			"Date"s,
-			"Swiss Current Rate ON"s,
+			{ "Swiss Current Rate ON", "Swiss Current Index ON" }, // SARONCompoundedIndex is the same file
 			';'
 		);
+		auto ts = move(columns[0]);
 
 		auto hs = make_SIX_holiday_schedule();
 
@@ -128,12 +131,7 @@ namespace risk_free_rate
 			starting_value
 		);
 
-		const auto expected = parse_csv(
-			SARONCompoundedIndex,
-			"Date"s,
-			"Swiss Current Index ON"s,
-			';'
-		);
+		const auto expected = move(columns[1]);
 //		EXPECT_EQ(expected, ci.get_time_series());
 		for (auto d = expected.get_period().get_from();
 			d <= expected.get_period().get_until();
@@ -150,6 +148,291 @@ namespace risk_free_rate
 		}
 	}
 
+	TEST(saron, make_compounded_rate_rolling)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		auto hs = make_SIX_holiday_schedule();
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto convention = &ModifiedPreceding;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 4u;
+
+		// we compare against the full recalculation of each window (rather than SIX data) for now
+		for (const auto term : { months{ 1 }, months{ 3 }, months{ 6 }, months{ 12 } })
+		{
+			const auto expected = make_compounded_rate(
+				term,
+				r,
+				from,
+				convention,
+				publication,
+				decimal_places
+			);
+			const auto cr = make_compounded_rate_rolling(
+				term,
+				r,
+				from,
+				convention,
+				publication,
+				decimal_places
+			);
+			EXPECT_EQ(expected.get_time_series(), cr.get_time_series());
+		}
+	}
+
+	TEST(saron, make_compounded_rate_par)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		auto hs = make_SIX_holiday_schedule();
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto convention = &ModifiedPreceding;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 4u;
+
+		for (const auto term : { months{ 1 }, months{ 3 }, months{ 6 }, months{ 12 } })
+		{
+			const auto expected = make_compounded_rate(
+				term,
+				r,
+				from,
+				convention,
+				publication,
+				decimal_places
+			);
+
+			auto cr = resets::storage{ expected.get_time_series().get_period() };
+			make_compounded_rate(
+				execution::par,
+				term,
+				r,
+				from,
+				convention,
+				publication,
+				decimal_places,
+				cr
+			);
+			EXPECT_EQ(expected.get_time_series(), cr);
+		}
+	}
+
+	TEST(saron, make_compounded_rate_par_throws)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+		ts[2020y / June / 2d] = nullopt;
+
+		auto hs = make_SIX_holiday_schedule();
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto convention = &ModifiedPreceding;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 4u;
+
+		// an exception leaving a parallel algorithm would terminate, so these are thrown before we start
+		auto cr = resets::storage{ days_period{ from, year_month_day{ sys_days{ r.last_reset_year_month_day() } + days{ 7 } } } };
+		EXPECT_THROW(
+			make_compounded_rate(
+				execution::par,
+				months{ 1 },
+				r,
+				from,
+				convention,
+				publication,
+				decimal_places,
+				cr
+			),
+			out_of_range
+		);
+
+		auto short_cr = resets::storage{ days_period{ from, 2000y / January / 31d } };
+		EXPECT_ANY_THROW(
+			make_compounded_rate(
+				execution::par,
+				months{ 1 },
+				resets{ parse_csv(SARON, "Date"s, "Swiss Average Rate ON"s, ';'), &Actual360 },
+				from,
+				convention,
+				publication,
+				decimal_places,
+				short_cr
+			)
+		);
+	}
+
+	template<typename View>
+	concept _can_start_at = requires(View&& v, const year_month_day& d) { std::forward<View>(v).starting_at(d); };
+
+	TEST(saron, compounded_rate_at)
+	{
+		auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		auto hs = make_SIX_holiday_schedule();
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto from = 1999y / June / 30d;
+		const auto term = months{ 3 };
+		const auto convention = &ModifiedPreceding;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 4u;
+
+		const auto expected = make_compounded_rate(
+			term,
+			r,
+			from,
+			convention,
+			publication,
+			decimal_places
+		);
+		const auto& expected_ts = expected.get_time_series();
+
+		// a handful of point queries through the history
+		for (const auto maturity : { 2001y / March / 30d, 2008y / October / 15d, 2015y / January / 15d, 2022y / June / 30d })
+		{
+			EXPECT_TRUE(expected_ts[maturity]);
+			EXPECT_EQ(expected_ts[maturity], compounded_rate_at(maturity, term, convention, publication, r, decimal_places));
+		}
+
+		// the window starts before the first reset
+		EXPECT_FALSE(compounded_rate_at(r.get_time_series().get_period().get_from(), term, convention, publication, r, decimal_places));
+
+		// nothing is published for a Saturday
+		EXPECT_FALSE(expected_ts[2022y / June / 4d]);
+		EXPECT_FALSE(compounded_rate_at(2022y / June / 4d, term, convention, publication, r, decimal_places));
+
+		// the last rate is published on the maturity of the last reset, and nothing after it
+		const auto until = make_overnight_maturity(r.last_reset_year_month_day(), publication);
+		EXPECT_TRUE(compounded_rate_at(until, term, convention, publication, r, decimal_places));
+		EXPECT_EQ(expected_ts[until], compounded_rate_at(until, term, convention, publication, r, decimal_places));
+		EXPECT_FALSE(compounded_rate_at(make_overnight_maturity(until, publication), term, convention, publication, r, decimal_places));
+
+		const auto view = compounded_rate_view{ term, r, from, convention, publication, decimal_places };
+		static_assert(ranges::forward_range<decltype(view)>);
+		static_assert(_can_start_at<decltype(view)&>);
+		static_assert(!_can_start_at<decltype(view)>); // not on a temporary
+
+		auto count = 0u;
+		for (const auto& [maturity, rate] : view)
+		{
+			EXPECT_EQ(expected_ts[maturity], rate);
+			++count;
+		}
+		EXPECT_GT(count, 6000u);
+
+		// a default constructed iterator is at the end (rather than looking at a view which is not there)
+		EXPECT_TRUE(ranges::iterator_t<decltype(view)>{} == default_sentinel);
+
+		// lazily, only the rates we look at are compounded
+		auto rates = view.starting_at(2022y / June / 4d) | views::take(3);
+		auto maturity = 2022y / June / 7d; // the first business day after the 4th (the 6th is Whit Monday)
+		for (const auto& [m, rate] : rates)
+		{
+			EXPECT_EQ(maturity, m);
+			EXPECT_EQ(expected_ts[m], rate);
+			maturity = make_overnight_maturity(maturity, publication);
+		}
+		EXPECT_EQ(2022y / June / 10d, maturity);
+	}
+
+	TEST(saron, append_compounded_index2)
+	{
+		const auto ts = parse_csv(
+			SARON,
+			"Date"s,
+			"Swiss Average Rate ON"s,
+			';'
+		);
+
+		auto hs = make_SIX_holiday_schedule();
+
+		const auto from = 1999y / June / 30d;
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			move(hs)
+		};
+		const auto decimal_places = 6u;
+		const auto starting_value = 10'000.0;
+
+		const auto expected = make_compounded_index2(
+			resets{ ts, &Actual360 },
+			from,
+			publication,
+			decimal_places,
+			starting_value
+		);
+
+		// we start with the index published a week ago and then add one reset at a time
+		const auto last = ts.get_period().get_until();
+		auto d = sys_days{ last } - days{ 7 };
+		while (!ts[d])
+			d -= days{ 1 };
+
+		auto ci = compounded_index_series{ make_compounded_index2(
+			resets{ make_sub_storage(ts, { ts.get_period().get_from(), d }), &Actual360 },
+			from,
+			publication,
+			decimal_places,
+			starting_value
+		) };
+		auto state = compounded_index_state{
+			make_overnight_maturity(d, publication),
+			*ci[make_overnight_maturity(d, publication)]
+		};
+
+		// the values already there stay where they are (only the new days are added)
+		const auto& first_value = ci[from];
+
+		for (d += days{ 1 }; d <= sys_days{ last }; d += days{ 1 })
+			if (ts[d])
+				append_compounded_index2(
+					ci,
+					state,
+					resets{ make_sub_storage(ts, { d, d }), &Actual360 },
+					publication,
+					decimal_places
+				);
+
+		EXPECT_EQ(&first_value, &ci[from]);
+		EXPECT_EQ(expected.get_time_series(), ci.to_resets().get_time_series());
+	}
+
 /*
 	TEST(saron, start_date_1m)
 	{
@@ -0,0 +1,218 @@
+// The MIT License (MIT)
+//
+// Copyright (c) 2023 Andrey Gorbachev
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "setup.h"
+
+#include <scenario_resets.h>
+#include <compounded_rate.h>
+
+#include <day_counts.h>
+#include <compounding_schedule.h>
+
+#include <period.h>
+#include <weekend.h>
+#include <calendar.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+#include <optional>
+#include <random>
+
+
+using namespace coupon_schedule;
+
+using namespace gregorian;
+
+using namespace std;
+using namespace std::chrono;
+
+
+namespace risk_free_rate
+{
+
+	TEST(scenario_resets, compound)
+	{
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+
+		const auto scenarios = size_t{ 13u }; // not a multiple of the vector width
+		auto sr = scenario_resets{ r, scenarios };
+
+		const auto effective = 2022y / June / 30d;
+		const auto maturity = 2022y / September / 30d;
+		const auto schedule = make_compounding_schedule({ { effective, maturity }, maturity, maturity }, publication);
+
+		const auto expected = compound(schedule, r);
+		for (const auto& c : compound(schedule, sr))
+			EXPECT_EQ(expected, c);
+
+		// parallel shift of 1bp per scenario
+		for (const auto& p : schedule)
+			for (auto s = size_t{ 0u }; s < scenarios; ++s)
+				sr(p._reset, s) += s * 0.0001;
+
+		const auto cs = compound(schedule, sr);
+		ASSERT_EQ(scenarios, cs.size());
+		for (auto s = size_t{ 0u }; s < scenarios; ++s)
+		{
+			auto c = 1.0;
+			for (const auto& p : schedule)
+				c *= 1.0 + sr(p._reset, s) * Actual360.fraction(p._period);
+
+			EXPECT_EQ((c - 1.0) / Actual360.fraction({ effective, maturity }), cs[s]);
+		}
+
+		EXPECT_THROW(sr.row(1999y / January / 1d), out_of_range);
+	}
+
+
+	TEST(scenario_resets, kernels)
+	{
+		// every kernel the CPU supports gives the same bits as the scalar one
+		const auto scenarios = size_t{ 37u }; // not a multiple of any vector width
+
+		auto rates = vector<double>(scenarios);
+		for (auto s = size_t{ 0u }; s < scenarios; ++s)
+			rates[s] = -0.0075 + s * 0.00037;
+
+		auto expected = vector<double>(scenarios, 1.0);
+		for (auto day = 1; day <= 90; ++day)
+			_compound_scenarios_scalar(expected.data(), rates.data(), day % 7 == 5 ? 3.0 / 360.0 : 1.0 / 360.0, scenarios);
+
+		EXPECT_TRUE(_supports(_scenario_kernel::scalar));
+		EXPECT_TRUE(_supports(_best_scenario_kernel()));
+
+		for (const auto kernel : { _scenario_kernel::scalar, _scenario_kernel::avx2, _scenario_kernel::avx512 })
+		{
+			if (!_supports(kernel))
+				continue;
+
+			auto c = vector<double>(scenarios, 1.0);
+			for (auto day = 1; day <= 90; ++day)
+				_compound_scenarios(c.data(), rates.data(), day % 7 == 5 ? 3.0 / 360.0 : 1.0 / 360.0, scenarios, kernel);
+
+			EXPECT_EQ(expected, c) << "kernel " << static_cast<int>(kernel);
+		}
+	}
+
+	TEST(scenario_resets, kernels_random)
+	{
+		// every kernel the CPU supports gives the same bits as compound() on random rates
+		// (about 750 days by about 1000 scenarios, so a single contracted fma would almost certainly show up)
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+
+		const auto base = resets{ ts, &Actual360 };
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+
+		const auto effective = 2020y / January / 2d;
+		const auto maturity = 2022y / December / 30d;
+		const auto schedule = make_compounding_schedule({ { effective, maturity }, maturity, maturity }, publication);
+
+		const auto scenarios = size_t{ 1031u }; // not a multiple of any vector width
+		auto sr = scenario_resets{ base, scenarios };
+
+		auto generator = mt19937_64{ 2023u };
+		auto distribution = uniform_real_distribution{ -1.0, 10.0 }; // in percent
+
+		auto expected = vector<double>(scenarios);
+		for (auto s = size_t{ 0u }; s < scenarios; ++s)
+		{
+			auto scenario = ts;
+			for (const auto& p : schedule)
+				scenario[p._reset] = distribution(generator);
+
+			const auto r = resets{ move(scenario), &Actual360 };
+			for (const auto& p : schedule)
+				sr(p._reset, s) = r[p._reset];
+
+			expected[s] = compound(schedule, r);
+		}
+
+		const auto full_year_fraction = Actual360.fraction({ effective, maturity });
+		for (const auto kernel : { _scenario_kernel::scalar, _scenario_kernel::avx2, _scenario_kernel::avx512 })
+		{
+			if (!_supports(kernel))
+				continue;
+
+			auto c = vector<double>(scenarios, 1.0);
+			for (const auto& p : schedule)
+				_compound_scenarios(c.data(), sr.row(p._reset), Actual360.fraction(p._period), scenarios, kernel);
+
+			for (auto s = size_t{ 0u }; s < scenarios; ++s)
+				EXPECT_EQ(expected[s], (c[s] - 1.0) / full_year_fraction) << "kernel " << static_cast<int>(kernel) << " scenario " << s;
+		}
+
+		// and the same through the public interface (whichever kernel is the best here)
+		EXPECT_EQ(expected, compound(schedule, sr));
+	}
+
+	TEST(scenario_resets, missing_reset)
+	{
+		auto ts = parse_csv(
+			EuroSTR,
+			"Period"s,
+			"Volume-weighted trimmed mean rate"s
+		);
+		ts[2022y / August / 1d] = nullopt;
+
+		const auto r = resets{ move(ts), &Actual360 };
+		const auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_TARGET2_holiday_schedule()
+		};
+
+		auto sr = scenario_resets{ r, 5u };
+
+		const auto effective = 2022y / June / 30d;
+		const auto maturity = 2022y / September / 30d;
+		const auto schedule = make_compounding_schedule({ { effective, maturity }, maturity, maturity }, publication);
+
+		// the same as the scalar compound()
+		EXPECT_THROW(compound(schedule, r), out_of_range);
+		EXPECT_THROW(compound(schedule, sr), out_of_range);
+
+		EXPECT_THROW(sr.row(2022y / August / 1d), out_of_range);
+		EXPECT_THROW(sr(2022y / August / 1d, 0u), out_of_range);
+		EXPECT_NO_THROW(sr.row(2022y / August / 2d));
+	}
+
+}
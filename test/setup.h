@@ -22,6 +22,9 @@
 
 #pragma once
 
+#include <fixing_file.h>
+#include <holiday_tables.h>
+
 #include <resets.h>
 
 #include <period.h>
@@ -35,6 +38,8 @@
 
 #include <chrono>
 #include <string>
+#include <string_view>
+#include <vector>
 #include <sstream>
 #include <memory>
 #include <optional>
@@ -138,6 +143,30 @@ namespace risk_free_rate
 		const string& observationColumnName,
 		const char separator = ','
 	) -> resets::storage
+	{
+		return load_fixings(fileName, dateColumnName, observationColumnName, separator);
+	}
+
+
+	// several columns of the same file in a single pass
+	inline auto parse_csv_columns(
+		const string& fileName,
+		const string& dateColumnName,
+		const vector<string_view>& observationColumnNames,
+		const char separator = ','
+	) -> vector<resets::storage>
+	{
+		return load_fixings(fileName, dateColumnName, observationColumnNames, separator);
+	}
+
+
+	// the original loader (kept to check load_fixings against it and to benchmark it)
+	inline auto parse_csv_rapidcsv(
+		const string& fileName,
+		const string& dateColumnName,
+		const string& observationColumnName,
+		const char separator = ','
+	) -> resets::storage
 	{
 		const auto csv = rapidcsv::Document(
 			fileName, 
@@ -170,7 +199,24 @@ namespace risk_free_rate
 	}
 
 
-	inline auto make_england_holiday_schedule() -> schedule
+	// part of the time series (for example to pretend that we are back in time)
+	inline auto make_sub_storage(
+		const resets::storage& ts,
+		const gregorian::days_period& from_until
+	) -> resets::storage
+	{
+		auto result = resets::storage{ from_until };
+
+		for (auto d = from_until.get_from(); d <= from_until.get_until(); d = sys_days{ d } + days{ 1 })
+			result[d] = ts[d];
+
+		return result;
+	}
+
+
+	// the rules behind the tables in holiday_tables.h (the library versions are checked against these)
+
+	inline auto make_england_holiday_schedule_from_rules() -> schedule
 	{
 		// from https://www.gov.uk/bank-holidays
 
@@ -226,7 +272,7 @@ namespace risk_free_rate
 			&GoodFriday,
 			&EasterMonday,
 			&EarlyMayBankHoliday,
-			&SpringBankHoliday,
+			&SpringBankHoliday2,
 			&PlatinumJubileeHoliday,
 			&SummerBankHoliday,
 			&StateFuneral,
@@ -268,7 +314,7 @@ namespace risk_free_rate
 	}
 
 
-	inline auto make_TARGET2_holiday_schedule() -> schedule
+	inline auto make_TARGET2_holiday_schedule_from_rules() -> schedule
 	{
 		// from https://www.ecb.europa.eu/paym/target/target2/profuse/calendar/html/index.en.html
 
@@ -290,7 +336,7 @@ namespace risk_free_rate
 	}
 
 
-	inline auto make_SIX_holiday_schedule() -> schedule
+	inline auto make_SIX_holiday_schedule_from_rules() -> schedule
 	{
 		// from https://www.six-group.com/en/products-services/the-swiss-stock-exchange/market-data/news-tools/trading-currency-holiday-calendar.html#/
 
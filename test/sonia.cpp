@@ -37,6 +37,7 @@
 
 #include <chrono>
 #include <memory>
+#include <execution>
 
 
 using namespace coupon_schedule;
@@ -102,4 +103,37 @@ namespace risk_free_rate
 		}
 	}
 
+	TEST(sonia, make_compounded_index_par)
+	{
+		auto ts = parse_csv(
+			SONIA,
+			"Date"s,
+			"Daily Sterling overnight index average (SONIA) rate              [a] [b]             IUDSOIA"s
+		);
+
+		const auto r = resets{ move(ts), &Actual365Fixed };
+		const auto from = 2018y / April / 23d;
+		auto publication = calendar{
+			SaturdaySundayWeekend,
+			make_england_holiday_schedule()
+		};
+		publication.substitute(&Following);
+		const auto decimal_places = 8u;
+		const auto ci = make_compounded_index(
+			execution::par,
+			r,
+			from,
+			publication,
+			decimal_places
+		);
+
+		const auto expected = make_compounded_index(
+			r,
+			from,
+			publication,
+			decimal_places
+		);
+		EXPECT_EQ(expected.get_time_series(), ci.get_time_series());
+	}
+
 }